@@ -0,0 +1,73 @@
+// Cycle counter for the kernels of kernel.hdr. Timer1 runs with the CPU clock
+// and counts its overflows, so each kernel call is measured in cycles. The
+// results are written to the register at 0x20 that simulavr pipes to stdout
+// ('-W 0x20,-').
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include <stdint.h>
+
+#define PIPE (*(volatile uint8_t *)0x20)
+
+void init(void);
+void fir(void);
+void lowpass(void);
+void gain(void);
+
+static volatile uint16_t overflows;
+
+ISR(TIMER1_OVF_vect)
+{
+    ++overflows;
+}
+
+static void
+put(const char *s)
+{
+    while (*s) {
+	PIPE = *s++;
+    }
+}
+
+static void
+putNumber(uint32_t n)
+{
+    char buf[11];
+    char *p = buf + sizeof(buf) - 1;
+    *p = 0;
+    do {
+	*--p = '0' + n % 10;
+	n /= 10;
+    } while (n);
+    put(p);
+}
+
+static void
+measure(const char *name, void (*fn)(void))
+{
+    TCCR1A = 0;
+    TCCR1B = 0;
+    TCNT1 = 0;
+    overflows = 0;
+    TIMSK1 = 1 << TOIE1;
+    sei();
+    TCCR1B = 1 << CS10;
+    fn();
+    TCCR1B = 0;
+    cli();
+    uint32_t cycles = ((uint32_t)overflows << 16) | TCNT1;
+    put(name);
+    put(" ");
+    putNumber(cycles);
+    put("\n");
+}
+
+int
+main(void)
+{
+    init();
+    measure("fir", fir);
+    measure("lowpass", lowpass);
+    measure("gain", gain);
+    return 0;
+}
@@ -0,0 +1,56 @@
+#!/usr/bin/env bash
+#
+# Fixed-point benchmark for MCUs without FPU: compiles the kernels of
+# kernel.hdr for 'float' (soft-float library calls) and for the fixed-point
+# types 'fixed[16, 16]' and 'fixed[8, 8]' (integer instructions), links them
+# with harness.c and runs them in simulavr. Reports the flash size and the
+# number of CPU cycles of each kernel.
+#
+# usage: run.sh [ -O level ] [ -m mcu ]
+#
+
+root=$(cd ../.. && pwd)
+ABC=${ABC:-$root/build/abc/abc}
+CC=${CC:-avr-gcc}
+SIZE=${SIZE:-avr-size}
+SIMULAVR=${SIMULAVR:-simulavr}
+WORK=${WORK:-work}
+PROGRAMS=${PROGRAMS-"float fixed16 fixed8"}
+FUNCTIONS="fir lowpass gain"
+
+O=s
+MCU=atmega328p
+while getopts O:m: opt; do
+    case $opt in
+    O) O=$OPTARG ;;
+    m) MCU=$OPTARG ;;
+    *) echo "usage: $0 [ -O level ] [ -m mcu ]" >&2; exit 1 ;;
+    esac
+done
+
+mkdir -p $WORK || exit 1
+
+failed=0
+
+printf "%-12s %-10s %8s" "(-O$O)" type flash
+for fn in $FUNCTIONS; do
+    printf " %10s" $fn
+done
+printf "\n"
+
+for p in $PROGRAMS; do
+    obj=$WORK/$p.o
+    elf=$WORK/$p.elf
+    $ABC -O$O -mmcu=$MCU -c $p.abc -o $obj || { failed=1; continue; }
+    $CC -O$O -mmcu=$MCU harness.c $obj -o $elf || { failed=1; continue; }
+    read text data bss rest < <($SIZE $elf | tail -1)
+    out=$($SIMULAVR -d $MCU -f $elf -W 0x20,- -T exit 2>/dev/null)
+    printf "%-12s %-10s %8s" $MCU $p $((text + data))
+    for fn in $FUNCTIONS; do
+	cycles=$(awk -v fn=$fn '$1 == fn { print $2 }' <<< "$out")
+	printf " %10s" ${cycles:-?}
+    done
+    printf "\n"
+done
+
+exit $failed
@@ -0,0 +1,69 @@
+#!/usr/bin/env bash
+#
+# Integer model benchmark for 8-bit targets: compiles kernel.abc for an AVR MCU
+# and reports the flash size (text + data) of the object file and the number
+# of instructions of each function. With a 16-bit int and size_t the loop
+# counters, indices and integer literals need half as many registers and
+# instructions as with the 32/64-bit widths of the host.
+#
+# Set ABC_BASE to a second compiler (e.g. a build of an older revision) to get
+# both columns side by side.
+#
+# usage: run.sh [ -O level ] [ -m mcu ]
+#
+
+root=$(cd ../.. && pwd)
+ABC=${ABC:-$root/build/abc/abc}
+ABC_BASE=${ABC_BASE:-}
+SIZE=${SIZE:-llvm-size}
+OBJDUMP=${OBJDUMP:-llvm-objdump}
+WORK=${WORK:-work}
+FUNCTIONS=${FUNCTIONS-"fill checksum count"}
+
+O=s
+MCU=atmega328p
+while getopts O:m: opt; do
+    case $opt in
+    O) O=$OPTARG ;;
+    m) MCU=$OPTARG ;;
+    *) echo "usage: $0 [ -O level ] [ -m mcu ]" >&2; exit 1 ;;
+    esac
+done
+
+flags="-O$O -mmcu=$MCU -c"
+
+mkdir -p $WORK || exit 1
+
+# number of instructions of function $2 in object file $1
+instructions() {
+    $OBJDUMP -d $1 | awk -v fn="<$2>:" '
+	$2 == fn { inside = 1; next }
+	/^$/ { inside = 0 }
+	inside && /^ *[0-9a-f]+:/ { ++n }
+	END { print n + 0 }'
+}
+
+failed=0
+compilers="ABC"
+if [ -n "$ABC_BASE" ]; then
+    compilers="ABC_BASE ABC"
+fi
+
+printf "%-12s %-10s %8s" "(-O$O)" compiler flash
+for fn in $FUNCTIONS; do
+    printf " %10s" $fn
+done
+printf "\n"
+
+for c in $compilers; do
+    obj=$WORK/kernel-$c.o
+    ${!c} $flags kernel.abc -o $obj || { failed=1; continue; }
+    read text data bss rest < <($SIZE $obj | tail -1)
+    printf "%-12s %-10s %8s" $MCU $c $((text + data))
+    for fn in $FUNCTIONS; do
+	printf " %10s" $(instructions $obj $fn)
+    done
+    printf "\n"
+done
+
+exit $failed
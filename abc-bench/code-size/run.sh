@@ -0,0 +1,63 @@
+#!/usr/bin/env bash
+#
+# Code size benchmark: links each program statically, once with one section per
+# function and global variable (the default for -static and -mmcu) and once
+# without. Reports the sizes of the text, data and bss segments, the flash size
+# (text + data) and the size of the executable.
+#
+# Programs for an MCU can be measured by setting ABCFLAGS, for example
+#   ABCFLAGS="-mmcu=atmega328p" ./run.sh
+# as long as the C compiler used by abc can link for that target.
+#
+# usage: run.sh [ -O level ]
+#
+
+root=$(cd ../.. && pwd)
+ABC=${ABC:-$root/build/abc/abc}
+SIZE=${SIZE:-size}
+WORK=${WORK:-work}
+PROGRAMS=${PROGRAMS-"misc/arduino_blinking_led misc/printf misc/list
+    02_calculator/xtest_calc:lexer,parser"}
+
+O=s
+while getopts O: opt; do
+    case $opt in
+    O) O=$OPTARG ;;
+    *) echo "usage: $0 [ -O level ]" >&2; exit 1 ;;
+    esac
+done
+
+flags="-O$O -static -I $root/abc-include -I $root/build -L $root/build"
+flags="$flags $ABCFLAGS"
+
+mkdir -p $WORK || exit 1
+
+failed=0
+printf "%-28s %-9s %9s %9s %9s %9s %10s\n" program sections text data bss \
+    flash file
+
+for p in $PROGRAMS; do
+    main=${p%%:*}
+    dir=$root/abc-example/$(dirname $main)
+    src=$dir/$(basename $main).abc
+    if [ "$p" != "$main" ]; then
+	for m in $(echo ${p#*:} | tr , ' '); do
+	    src="$src $dir/$m.abc"
+	done
+    fi
+    for sections in no yes; do
+	exe=$WORK/$(basename $main)-$sections
+	if [ $sections = no ]; then
+	    extra="-fno-function-sections -fno-data-sections"
+	else
+	    extra=
+	fi
+	$ABC $flags $extra $src -o $exe || { failed=1; continue; }
+	read text data bss rest < <($SIZE $exe | tail -1)
+	printf "%-28s %-9s %9s %9s %9s %9s %10s\n" $(basename $main) \
+	    $sections $text $data $bss $((text + data)) \
+	    $(wc -c < $exe | tr -d ' ')
+    done
+done
+
+exit $failed
@@ -0,0 +1,104 @@
+#!/bin/sh
+#
+# Compile-time benchmark: generates a corpus of synthetic ABC programs with
+# util/xtest_gen_abc_program, compiles each with 'abc -c -ftime-report' at
+# every optimization level and compares the result against 'baseline.txt'.
+#
+# usage: run.sh [ -b ] [ -t tolerance ]
+#   -b  record a new baseline.txt instead of comparing
+#   -t  allowed slowdown / memory growth in percent (default: 20)
+#
+
+ABC=${ABC:-../../build/abc/abc}
+GEN=${GEN:-../../build/util/xtest_gen_abc_program}
+OPT_LEVELS=${OPT_LEVELS:-"0 1 2 3 s z"}
+WORK=${WORK:-work}
+
+record=0
+tolerance=20
+while getopts bt: opt; do
+    case $opt in
+    b) record=1 ;;
+    t) tolerance=$OPTARG ;;
+    *) echo "usage: $0 [ -b ] [ -t tolerance ]" >&2; exit 1 ;;
+    esac
+done
+
+# without recorded rows every comparison would pass
+if [ $record -eq 0 ] && ! grep -qv '^#' baseline.txt; then
+    echo "$0: baseline.txt has no data, record it with 'make baseline'" >&2
+    exit 1
+fi
+
+# name and generator arguments of each program in the corpus
+corpus() {
+    cat <<CORPUS
+small -f 10
+fn100 -f 100
+fn1000 -f 1000
+fn5000 -f 5000
+deep16 -f 50 -d 16
+deep64 -f 50 -d 64
+expr256 -f 50 -e 256
+expr2048 -f 10 -e 2048
+wide512 -f 50 -w 512
+init64k -f 10 -i 65536
+include256 -f 50 -n 256
+macro256 -f 50 -m 256
+CORPUS
+}
+
+result=results.txt
+echo "# config opt parse_ms codegen_ms backend_ms total_ms maxrss_kb" > $result
+
+corpus | while read name args; do
+    $GEN $args $WORK/$name || exit 1
+    for O in $OPT_LEVELS; do
+	report=$($ABC -c -O$O -ftime-report -I $WORK/$name \
+		$WORK/$name/prog.abc -o $WORK/$name/prog.o 2>&1 \
+		| grep '^time-report:')
+	if [ -z "$report" ]; then
+	    echo "$name -O$O: compilation failed" >&2
+	    exit 1
+	fi
+	echo "$report" | awk -v name=$name -v O=O$O '{
+	    for (i = 2; i <= NF; ++i) {
+		split($i, kv, "=");
+		val[kv[1]] = kv[2];
+	    }
+	    print name, O, val["parse_ms"], val["codegen_ms"],
+		  val["backend_ms"], val["total_ms"], val["maxrss_kb"];
+	}' >> $result
+    done
+done || exit 1
+
+cat $result
+
+if [ $record -eq 1 ]; then
+    # keep the comment in front of the column names
+    awk -v header="$(head -1 $result)" '$0 == header { exit } { print }' \
+	baseline.txt > baseline.new
+    cat $result >> baseline.new
+    mv baseline.new baseline.txt
+    exit 0
+fi
+
+# report configurations that got slower or bigger than the tolerance allows
+awk -v tol=$tolerance '
+    /^#/ { next }
+    FNR == NR { time[$1 " " $2] = $6; rss[$1 " " $2] = $7; next }
+    ($1 " " $2) in time {
+	key = $1 " " $2;
+	if ($6 > time[key] * (1 + tol / 100)) {
+	    printf "REGRESSION %s: total %.1f ms (baseline %.1f ms)\n",
+		   key, $6, time[key];
+	    failed = 1;
+	}
+	if ($7 > rss[key] * (1 + tol / 100)) {
+	    printf "REGRESSION %s: maxrss %d kB (baseline %d kB)\n",
+		   key, $7, rss[key];
+	    failed = 1;
+	}
+    }
+    END { exit failed }
+' baseline.txt $result
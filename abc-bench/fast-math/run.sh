@@ -0,0 +1,72 @@
+#!/usr/bin/env bash
+#
+# Floating-point codegen benchmark: compiles the dot product in dot.abc with
+# each of the floating-point options and reports the best-of-N wall time and
+# the speedup compared to the build without any of them. dot_fastmath.abc is
+# the same program with the 'fastmath' attribute on the function instead of a
+# command line option.
+#
+# The results may differ in the last digits, as reassociation and fusion change
+# the rounding.
+#
+# usage: run.sh [ -n repeat ] [ -O level ]
+#
+
+root=$(cd ../.. && pwd)
+ABC=${ABC:-$root/build/abc/abc}
+WORK=${WORK:-work}
+VARIANTS=${VARIANTS-"dot:
+    dot:-ffp-contract=on
+    dot:-ffp-contract=fast
+    dot:-fassociative-math
+    dot:-ffast-math
+    dot_fastmath:"}
+
+repeat=3
+O=3
+while getopts n:O: opt; do
+    case $opt in
+    n) repeat=$OPTARG ;;
+    O) O=$OPTARG ;;
+    *) echo "usage: $0 [ -n repeat ] [ -O level ]" >&2; exit 1 ;;
+    esac
+done
+
+ABCFLAGS="-O$O -I $root/abc-include -I $root/build -L $root/build"
+
+mkdir -p $WORK || exit 1
+
+# best wall time in seconds of 'repeat' runs of $1
+best_time() {
+    local prog=$1 t best=
+    local TIMEFORMAT=%R
+    for ((n = 0; n < repeat; ++n)); do
+	t=$( { time $prog > /dev/null 2>&1; } 2>&1 )
+	if [ -z "$best" ] || awk "BEGIN { exit !($t < $best) }"; then
+	    best=$t
+	fi
+    done
+    echo $best
+}
+
+ratio() {
+    awk "BEGIN { printf \"%.2f\", ($2 > 0) ? $1 / $2 : 0 }"
+}
+
+failed=0
+baseTime=
+printf "%-36s %10s %8s %14s\n" "program (-O$O)" time_s speedup result
+
+for v in $VARIANTS; do
+    src=${v%%:*}
+    flag=${v#*:}
+    exe=$WORK/$src${flag:+-${flag#-}}
+    $ABC $ABCFLAGS $flag $src.abc -o $exe || { failed=1; continue; }
+    result=$($exe)
+    t=$(best_time $exe)
+    baseTime=${baseTime:-$t}
+    printf "%-36s %10s %8s %14s\n" "$src $flag" $t $(ratio $baseTime $t) \
+	$result
+done
+
+exit $failed
@@ -0,0 +1,84 @@
+#!/bin/sh
+#
+# Incremental compilation benchmark: generates a large synthetic ABC program
+# (about 20k lines) with util/xtest_gen_abc_program and measures
+#
+#   full     'abc -c' without cache
+#   cold     'abc -c -fincremental-cache' with an empty cache
+#   warm     same again, nothing changed
+#   edit     same again after changing the body of one function
+#
+# The programs built by full and incremental compilation must return the
+# same exit status.
+#
+# usage: run.sh [ -O level ] [ -f numFn ]
+#
+
+ABC=${ABC:-../../build/abc/abc}
+GEN=${GEN:-../../build/util/xtest_gen_abc_program}
+CC=${CC:-cc}
+WORK=${WORK:-work}
+
+O=0
+numFn=1000
+while getopts O:f: opt; do
+    case $opt in
+    O) O=$OPTARG ;;
+    f) numFn=$OPTARG ;;
+    *) echo "usage: $0 [ -O level ] [ -f numFn ]" >&2; exit 1 ;;
+    esac
+done
+
+rm -rf $WORK
+$GEN -f $numFn $WORK || exit 1
+echo "$(wc -l < $WORK/prog.abc) lines, $numFn functions, -O$O"
+
+# compile and print 'total_ms' and the cache statistics of the time report
+compile() {
+    report=$($ABC -c -O$O -ftime-report -I $WORK "$@" $WORK/prog.abc \
+	    -o $WORK/prog.o 2>&1 | grep '^time-report:')
+    if [ -z "$report" ]; then
+	echo "compilation failed" >&2
+	exit 1
+    fi
+    echo "$report" | awk '{
+	for (i = 2; i <= NF; ++i) {
+	    split($i, kv, "=");
+	    val[kv[1]] = kv[2];
+	}
+	printf "%10.1f ms", val["total_ms"];
+	if ("cache_parts" in val) {
+	    printf "  (%d of %d parts cached)", val["cache_hits"],
+		   val["cache_parts"];
+	}
+	printf "\n";
+    }'
+}
+
+status() {
+    $CC $WORK/prog.o -o $WORK/prog || exit 1
+    $WORK/prog
+    echo $?
+}
+
+cache="-fincremental-cache=$WORK/cache"
+
+printf "%-6s" full; compile || exit 1
+full=$(status)
+printf "%-6s" cold; compile $cache || exit 1
+printf "%-6s" warm; compile $cache || exit 1
+incremental=$(status)
+
+# change one function in the middle of the file
+mid=$((numFn / 2))
+sed -i.orig "/^fn f$mid(/,/^}/s/local x: int = a;/local x: int = a + 1;/" \
+    $WORK/prog.abc
+printf "%-6s" edit; compile $cache || exit 1
+edited=$(status)
+printf "%-6s" full; compile || exit 1
+full_edited=$(status)
+
+if [ "$full" != "$incremental" ] || [ "$edited" != "$full_edited" ]; then
+    echo "MISMATCH: full and incremental build return different results"
+    exit 1
+fi
@@ -0,0 +1,114 @@
+#!/bin/sh
+#
+# IR quality check: compiles every program under abc-example at each level in
+# OPT_LEVELS with --emit-llvm, collects per function metrics with
+# gen/xtest_ir_metrics and compares them against 'baseline.txt'. Functions
+# whose instruction count, number of allocas, loads + stores or alloca size
+# grew by more than the tolerance are reported.
+#
+# usage: run.sh [ -b ] [ -t tolerance ]
+#   -b  record a new baseline.txt instead of comparing
+#   -t  allowed growth in percent (default: 5)
+#
+
+root=$(cd ../.. && pwd)
+ABC=${ABC:-$root/build/abc/abc}
+METRICS=${METRICS:-$root/build/gen/xtest_ir_metrics}
+OPT_LEVELS=${OPT_LEVELS:-"0 2"}
+WORK=${WORK:-$(pwd)/work}
+
+record=0
+tolerance=5
+while getopts bt: opt; do
+    case $opt in
+    b) record=1 ;;
+    t) tolerance=$OPTARG ;;
+    *) echo "usage: $0 [ -b ] [ -t tolerance ]" >&2; exit 1 ;;
+    esac
+done
+
+# without recorded rows every comparison would pass
+if [ $record -eq 0 ] && ! grep -qv '^#' baseline.txt; then
+    echo "$0: baseline.txt has no data, record it with 'make baseline'" >&2
+    exit 1
+fi
+
+result=$(pwd)/results.txt
+echo "# opt file function insts bbs allocas loads stores alloca_bytes" \
+    > $result
+
+for dir in $root/abc-example/*/; do
+    dir=$(basename $dir)
+    mkdir -p $WORK/$dir
+    for src in $root/abc-example/$dir/*.abc; do
+	src=$(basename $src)
+	for O in $OPT_LEVELS; do
+	    ll=$WORK/$dir/${src%.abc}-O$O.ll
+	    # headers are included relative to the example directory
+	    if ! (cd $root/abc-example/$dir && $ABC --emit-llvm -O$O \
+		    -I $root/abc-include -I $root/build $src -o $ll) \
+		    > /dev/null 2>&1; then
+		echo "skipped: $dir/$src -O$O (does not compile)" >&2
+		continue
+	    fi
+	    $METRICS $ll | awk -v key="O$O $dir/$src" '{ $1 = key; print }' \
+		>> $result
+	done
+    done
+done
+
+awk '!/^#/ {
+    insts[$1] += $4; allocas[$1] += $6; mem[$1] += $7 + $8; size[$1] += $9;
+}
+END {
+    for (O in insts) {
+	printf "%s total: insts %d, allocas %d, loads+stores %d, alloca %d bytes\n",
+	       O, insts[O], allocas[O], mem[O], size[O];
+    }
+}' $result
+
+if [ $record -eq 1 ]; then
+    # keep the comment in front of the column names
+    awk -v header="$(head -1 $result)" '$0 == header { exit } { print }' \
+	baseline.txt > baseline.new
+    cat $result >> baseline.new
+    mv baseline.new baseline.txt
+    exit 0
+fi
+
+# report functions that grew, biggest growth first
+awk -v tol=$tolerance '
+    function grew(now, base) {
+	return now > base * (1 + tol / 100) && now > base + 1;
+    }
+    /^#/ { next }
+    FNR == NR {
+	key = $1 " " $2 " " $3;
+	insts[key] = $4; allocas[key] = $6; mem[key] = $7 + $8; size[key] = $9;
+	next;
+    }
+    {
+	key = $1 " " $2 " " $3;
+	if (!(key in insts)) {
+	    next;
+	}
+	what = "";
+	if (grew($4, insts[key])) {
+	    what = what sprintf(" insts %d -> %d", insts[key], $4);
+	}
+	if (grew($6, allocas[key])) {
+	    what = what sprintf(" allocas %d -> %d", allocas[key], $6);
+	}
+	if (grew($7 + $8, mem[key])) {
+	    what = what sprintf(" loads+stores %d -> %d", mem[key], $7 + $8);
+	}
+	if (grew($9, size[key])) {
+	    what = what sprintf(" alloca bytes %d -> %d", size[key], $9);
+	}
+	if (what != "") {
+	    growth = insts[key] ? ($4 - insts[key]) / insts[key] : $4;
+	    printf "%f GREW %s:%s\n", growth, key, what;
+	}
+    }
+' baseline.txt $result | sort -rn | cut -d' ' -f2- | grep . && exit 1
+exit 0
@@ -0,0 +1,70 @@
+#!/bin/sh
+#
+# Memory benchmark for the multi-file driver: compiles many copies of a small
+# synthetic ABC program with a single 'abc -c -ftime-report' invocation and
+# checks that peak memory stays flat, i.e. that no per-file compiler state
+# survives into the next input file.
+#
+# usage: run.sh [ -n numFiles ] [ -t tolerance ]
+#   -n  number of input files (default: 1000)
+#   -t  allowed growth of maxrss between file 100 and the last file in
+#       percent (default: 5)
+#
+
+ABC=${ABC:-../../build/abc/abc}
+GEN=${GEN:-../../build/util/xtest_gen_abc_program}
+WORK=${WORK:-work}
+
+num=1000
+tolerance=5
+while getopts n:t: opt; do
+    case $opt in
+    n) num=$OPTARG ;;
+    t) tolerance=$OPTARG ;;
+    *) echo "usage: $0 [ -n numFiles ] [ -t tolerance ]" >&2; exit 1 ;;
+    esac
+done
+if [ $num -lt 100 ]; then
+    echo "$0: need at least 100 input files" >&2
+    exit 1
+fi
+
+ABC=$(cd $(dirname $ABC) && pwd)/$(basename $ABC)
+
+rm -rf $WORK
+$GEN -f 20 -n 2 $WORK/src || exit 1
+i=1
+while [ $i -le $num ]; do
+    cp $WORK/src/prog.abc $WORK/prog$i.abc
+    i=$((i + 1))
+done
+
+files=$(i=1; while [ $i -le $num ]; do echo prog$i.abc; i=$((i + 1)); done)
+(cd $WORK && $ABC -c -ftime-report -I src $files 2> time-report.txt) || {
+    grep -v '^time-report:' $WORK/time-report.txt >&2
+    exit 1
+}
+
+# maxrss after file 100 and after the last file
+awk -v tol=$tolerance '
+    /^time-report:/ {
+	for (i = 2; i <= NF; ++i) {
+	    split($i, kv, "=");
+	    val[kv[1]] = kv[2];
+	}
+	++n;
+	if (n == 100) {
+	    ref = val["maxrss_kb"];
+	}
+	last = val["maxrss_kb"];
+    }
+    END {
+	printf "files %d: maxrss at file 100 %d kB, at last file %d kB\n",
+	       n, ref, last;
+	if (last > ref * (1 + tol / 100)) {
+	    printf "REGRESSION: maxrss grew by %.1f%% (tolerance %d%%)\n",
+		   (last / ref - 1) * 100, tol;
+	    exit 1;
+	}
+    }
+' $WORK/time-report.txt
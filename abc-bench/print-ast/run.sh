@@ -0,0 +1,38 @@
+#!/usr/bin/env bash
+#
+# Printer benchmark: generates a large program with util/xtest_gen_abc_program
+# and measures 'abc -E' writing to stdout and to a file ('-E -o file'). Reports
+# the wall time and, if strace is available, the number of write syscalls.
+#
+# usage: run.sh [ generator options ]   (default: -f 20000)
+#
+
+root=$(cd ../.. && pwd)
+ABC=${ABC:-$root/build/abc/abc}
+GEN=${GEN:-$root/build/util/xtest_gen_abc_program}
+WORK=${WORK:-work}
+
+genFlags=${*:-"-f 20000"}
+$GEN $genFlags $WORK || exit 1
+
+abcE="$ABC -E -I $WORK $WORK/prog.abc"
+
+wall_time() {
+    local TIMEFORMAT=%R
+    { time "$@" > /dev/null 2>&1; } 2>&1
+}
+
+write_calls() {
+    if ! command -v strace > /dev/null; then
+	echo "n/a"
+	return
+    fi
+    strace -f -c -e trace=write -o $WORK/strace.out "$@" > /dev/null 2>&1
+    awk '$NF == "write" { print $4 }' $WORK/strace.out
+}
+
+printf "%-10s %10s %12s\n" output wall_s write_calls
+printf "%-10s %10s %12s\n" stdout "$(wall_time $abcE)" "$(write_calls $abcE)"
+printf "%-10s %10s %12s\n" file \
+    "$(wall_time $abcE -o $WORK/prog.E)" \
+    "$(write_calls $abcE -o $WORK/prog.E)"
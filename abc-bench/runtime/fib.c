@@ -0,0 +1,20 @@
+#include <stdint.h>
+#include <stdio.h>
+
+#define N 35
+
+uint64_t
+fib(int n)
+{
+    if (n < 2) {
+	return n;
+    }
+    return fib(n - 1) + fib(n - 2);
+}
+
+int
+main(void)
+{
+    printf("%llu\n", (unsigned long long)fib(N));
+    return 0;
+}
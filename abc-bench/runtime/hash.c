@@ -0,0 +1,71 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define SIZE (1 << 22)
+#define N (SIZE / 2)
+
+uint64_t key[SIZE];
+bool used[SIZE];
+
+uint64_t
+hash(uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    return x;
+}
+
+bool
+insert(uint64_t k)
+{
+    uint64_t i = hash(k) & (SIZE - 1);
+    while (used[i]) {
+	if (key[i] == k) {
+	    return false;
+	}
+	i = (i + 1) & (SIZE - 1);
+    }
+    used[i] = true;
+    key[i] = k;
+    return true;
+}
+
+bool
+contains(uint64_t k)
+{
+    uint64_t i = hash(k) & (SIZE - 1);
+    while (used[i]) {
+	if (key[i] == k) {
+	    return true;
+	}
+	i = (i + 1) & (SIZE - 1);
+    }
+    return false;
+}
+
+int
+main(void)
+{
+    uint64_t seed = 42;
+    uint64_t inserted = 0;
+    for (int i = 0; i < N; ++i) {
+	seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+	if (insert(seed >> 16)) {
+	    ++inserted;
+	}
+    }
+
+    uint64_t found = 0;
+    seed = 42;
+    for (int i = 0; i < 2 * N; ++i) {
+	seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+	if (contains(seed >> 16)) {
+	    ++found;
+	}
+    }
+    printf("%llu %llu\n", (unsigned long long)inserted,
+           (unsigned long long)found);
+    return 0;
+}
@@ -0,0 +1,37 @@
+#include <stdio.h>
+
+#define N 256
+#define REPS 4
+
+double a[N][N], b[N][N], c[N][N];
+
+int
+main(void)
+{
+    for (int i = 0; i < N; ++i) {
+	for (int j = 0; j < N; ++j) {
+	    a[i][j] = (double)(i + j) / N;
+	    b[i][j] = (double)(i - j) / N;
+	    c[i][j] = 0;
+	}
+    }
+    for (int r = 0; r < REPS; ++r) {
+	for (int i = 0; i < N; ++i) {
+	    for (int k = 0; k < N; ++k) {
+		double aik = a[i][k];
+		for (int j = 0; j < N; ++j) {
+		    c[i][j] += aik * b[k][j];
+		}
+	    }
+	}
+    }
+
+    double sum = 0;
+    for (int i = 0; i < N; ++i) {
+	for (int j = 0; j < N; ++j) {
+	    sum += c[i][j];
+	}
+    }
+    printf("%.6e\n", sum);
+    return 0;
+}
@@ -0,0 +1,107 @@
+#!/usr/bin/env bash
+#
+# Runtime benchmark: compiles each kernel <k>.abc with abc and its C twin <k>.c
+# with cc at the same optimization level, checks that both print the same
+# result and reports the best-of-N wall time and the ratio abc / cc.
+#
+# The calculators from abc-example/02_* to 07_* have no C twin. They are built
+# with abc at each level, fed a fixed generated input and compared against the
+# abc -O0 build instead.
+#
+# usage: run.sh [ -n repeat ]
+#
+
+root=$(cd ../.. && pwd)
+ABC=${ABC:-$root/build/abc/abc}
+CC=${CC:-cc}
+OPT_LEVELS=${OPT_LEVELS:-"0 1 2 3"}
+WORK=${WORK:-work}
+KERNELS=${KERNELS-"matmul sort hash strscan fib"}
+CALCULATORS=${CALCULATORS-"02_calculator:xtest_calc 03_expression_tree:xtest_calc
+    04_symtab:xtest_calc 05_code_gen:xtest_calc 06_load_condition:xtest_abc
+    07_test:xtest_calc"}
+
+repeat=3
+while getopts n: opt; do
+    case $opt in
+    n) repeat=$OPTARG ;;
+    *) echo "usage: $0 [ -n repeat ]" >&2; exit 1 ;;
+    esac
+done
+
+ABCFLAGS="-I $root/abc-include -I $root/build -L $root/build"
+
+mkdir -p $WORK || exit 1
+
+# best wall time in seconds of 'repeat' runs of: $2 < $1
+best_time() {
+    local input=$1 prog=$2 t best=
+    local TIMEFORMAT=%R
+    for ((n = 0; n < repeat; ++n)); do
+	t=$( { time $prog < $input > /dev/null 2>&1; } 2>&1 )
+	if [ -z "$best" ] || awk "BEGIN { exit !($t < $best) }"; then
+	    best=$t
+	fi
+    done
+    echo $best
+}
+
+ratio() {
+    awk "BEGIN { printf \"%.2f\", ($2 > 0) ? $1 / $2 : 0 }"
+}
+
+failed=0
+printf "%-22s %-4s %10s %10s %8s\n" kernel opt abc_s cc_s ratio
+
+for k in $KERNELS; do
+    for O in $OPT_LEVELS; do
+	abcExe=$WORK/$k-abc-O$O
+	ccExe=$WORK/$k-cc-O$O
+	$ABC -O$O $ABCFLAGS $k.abc -o $abcExe || { failed=1; continue; }
+	$CC -O$O $k.c -o $ccExe || { failed=1; continue; }
+	if [ "$($abcExe)" != "$($ccExe)" ]; then
+	    echo "$k -O$O: abc and cc results differ" >&2
+	    failed=1
+	    continue
+	fi
+	abcTime=$(best_time /dev/null $abcExe)
+	ccTime=$(best_time /dev/null $ccExe)
+	printf "%-22s %-4s %10s %10s %8s\n" $k -O$O $abcTime $ccTime \
+	    $(ratio $abcTime $ccTime)
+    done
+done
+
+# fixed calculator input: many lines of integer expressions
+calcInput=$WORK/calc.input
+awk 'BEGIN {
+    srand(42);
+    for (i = 0; i < 200000; ++i) {
+	printf "(%d + %d) * %d - %d / (%d + 1);\n", int(rand() * 1000),
+	       int(rand() * 1000), int(rand() * 100), int(rand() * 1000),
+	       int(rand() * 100);
+    }
+    print ".";
+}' > $calcInput
+
+echo
+printf "%-22s %-4s %10s %10s %8s\n" calculator opt abc_s abc_O0_s ratio
+
+for c in $CALCULATORS; do
+    dir=${c%%:*}
+    prog=${c##*:}
+    O0Time=
+    for O in $OPT_LEVELS; do
+	build=$WORK/$dir-O$O
+	rm -rf $build
+	cp -R $root/abc-example/$dir $build || { failed=1; continue; }
+	make -s -C $build $prog CC=$ABC \
+	    CFLAGS="-O$O -I $root/abc-include -I $root/build" \
+	    LDFLAGS="-L $root/build" > /dev/null || { failed=1; continue; }
+	t=$(best_time $calcInput $build/$prog)
+	O0Time=${O0Time:-$t}
+	printf "%-22s %-4s %10s %10s %8s\n" $dir -O$O $t $O0Time \
+	    $(ratio $t $O0Time)
+    done
+done
+
+exit $failed
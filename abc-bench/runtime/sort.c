@@ -0,0 +1,60 @@
+#include <stdint.h>
+#include <stdio.h>
+
+#define N 2000000
+
+uint32_t v[N];
+
+void
+quicksort(uint32_t *a, int64_t lo, int64_t hi)
+{
+    while (lo < hi) {
+	uint32_t p = a[lo + (hi - lo) / 2];
+	int64_t i = lo, j = hi;
+	while (i <= j) {
+	    while (a[i] < p) {
+		++i;
+	    }
+	    while (a[j] > p) {
+		--j;
+	    }
+	    if (i <= j) {
+		uint32_t t = a[i];
+		a[i] = a[j];
+		a[j] = t;
+		++i;
+		--j;
+	    }
+	}
+	if (j - lo < hi - i) {
+	    quicksort(a, lo, j);
+	    lo = i;
+	} else {
+	    quicksort(a, i, hi);
+	    hi = j;
+	}
+    }
+}
+
+int
+main(void)
+{
+    uint32_t seed = 12345;
+    for (int64_t i = 0; i < N; ++i) {
+	seed = seed * 1103515245u + 12345u;
+	v[i] = seed;
+    }
+
+    quicksort(v, 0, N - 1);
+
+    uint64_t check = 0;
+    for (int64_t i = 0; i < N; ++i) {
+	if (i > 0 && v[i - 1] > v[i]) {
+	    printf("not sorted\n");
+	    return 1;
+	}
+	check = check * 31u + v[i];
+    }
+    printf("%llu\n", (unsigned long long)check);
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define SIZE (16 * 1024 * 1024)
+#define REPS 8
+
+char text[SIZE + 1];
+
+int
+main(void)
+{
+    uint32_t seed = 7;
+    for (int i = 0; i < SIZE; ++i) {
+	seed = seed * 1103515245u + 12345u;
+	uint32_t r = (seed >> 16) % 32;
+	if (r == 0) {
+	    text[i] = '\n';
+	} else if (r < 6) {
+	    text[i] = ' ';
+	} else {
+	    text[i] = 'a' + r - 6;
+	}
+    }
+    text[SIZE] = 0;
+
+    uint64_t lines = 0, words = 0, vowels = 0;
+    for (int r = 0; r < REPS; ++r) {
+	bool inWord = false;
+	for (char *p = text; *p; ++p) {
+	    char ch = *p;
+	    if (ch == '\n') {
+		++lines;
+	    }
+	    if (ch == ' ' || ch == '\n') {
+		inWord = false;
+	    } else if (!inWord) {
+		inWord = true;
+		++words;
+	    }
+	    if (ch == 'a' || ch == 'e' || ch == 'i' || ch == 'o' || ch == 'u') {
+		++vowels;
+	    }
+	}
+    }
+    printf("%llu %llu %llu\n", (unsigned long long)lines,
+           (unsigned long long)words, (unsigned long long)vowels);
+    return 0;
+}
@@ -0,0 +1,59 @@
+#!/usr/bin/env bash
+#
+# Struct-of-arrays benchmark: runs the same particle update (particles.hdr)
+# on an 'array[N] of Particle' and on a 'soa array[N] of Particle'. Reports the
+# best-of-N wall time and the speedup compared to the array of structs.
+#
+# usage: run.sh [ -n repeat ] [ -O level ]
+#
+
+root=$(cd ../.. && pwd)
+ABC=${ABC:-$root/build/abc/abc}
+WORK=${WORK:-work}
+PROGRAMS=${PROGRAMS-"aos soa"}
+
+repeat=3
+O=3
+while getopts n:O: opt; do
+    case $opt in
+    n) repeat=$OPTARG ;;
+    O) O=$OPTARG ;;
+    *) echo "usage: $0 [ -n repeat ] [ -O level ]" >&2; exit 1 ;;
+    esac
+done
+
+ABCFLAGS="-O$O -I $root/abc-include -I $root/build -L $root/build"
+
+mkdir -p $WORK || exit 1
+
+# best wall time in seconds of 'repeat' runs of $1
+best_time() {
+    local prog=$1 t best=
+    local TIMEFORMAT=%R
+    for ((n = 0; n < repeat; ++n)); do
+	t=$( { time $prog > /dev/null 2>&1; } 2>&1 )
+	if [ -z "$best" ] || awk "BEGIN { exit !($t < $best) }"; then
+	    best=$t
+	fi
+    done
+    echo $best
+}
+
+ratio() {
+    awk "BEGIN { printf \"%.2f\", ($2 > 0) ? $1 / $2 : 0 }"
+}
+
+failed=0
+baseTime=
+printf "%-20s %10s %8s %22s\n" "program (-O$O)" time_s speedup result
+
+for p in $PROGRAMS; do
+    exe=$WORK/$p
+    $ABC $ABCFLAGS $p.abc -o $exe || { failed=1; continue; }
+    result=$($exe)
+    t=$(best_time $exe)
+    baseTime=${baseTime:-$t}
+    printf "%-20s %10s %8s %22s\n" $p $t $(ratio $baseTime $t) $result
+done
+
+exit $failed
@@ -1,18 +1,37 @@
+#include <cctype>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <vector>
 
+#include <sys/resource.h>
+
+#ifdef SUPPORT_SOLARIS
+// has to be included as first llvm header
+#include "llvm/Support/Solaris/sys/regset.h"
+#endif // SUPPORT_SOLARIS
+
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "ast/perfcheck.hpp"
+#include "expr/callexpr.hpp"
 #include "expr/implicitcast.hpp"
 #include "gen/gen.hpp"
 #include "gen/print.hpp"
+#include "gen/stackdepth.hpp"
 #include "lexer/lexer.hpp"
 #include "lexer/macro.hpp"
 #include "lexer/reader.hpp"
 #include "parser/parser.hpp"
+#include "symtab/symtab.hpp"
 #include "type/inittypesystem.hpp"
+#include "util/json.hpp"
+#include "util/stats.hpp"
 
 #ifdef SUPPORT_CC
 #define str(s) #s
@@ -64,6 +83,33 @@ std::filesystem::path abcIncludeDir = xstr(ABC_INCLUDEDIR);
 std::filesystem::path abcIncludeDir = abcPrefix / "include" / "abc";
 #endif
 
+/*
+ * Phase timing (-ftime-report)
+ */
+
+using Clock = std::chrono::steady_clock;
+
+static double
+msSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start)
+        .count();
+}
+
+static long
+maxRssKb()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+//------------------------------------------------------------------------------
+
 void
 usage(const char *prog, int exit = 1)
 {
@@ -107,6 +153,65 @@ usage(const char *prog, int exit = 1)
         << "  -static \t\t\tOn systems that support dynamic linking, this\n"
            "          \t\t\tprevents linking with the shared libraries.  \n"
            "          \t\t\tOn other systems, this option has no effect.\n";
+    std::cerr << "  -ftime-report \t\tPrint time spent in each compiler "
+                 "phase and the\n"
+                 "          \t\t\tpeak memory usage.\n";
+    std::cerr << "  -fstats=<file>\t\t\tWrite counters that explain the "
+                 "compile cost\n"
+                 "          \t\t\tof each input file to <file> as JSON.\n";
+    std::cerr << "  -fstack-report=<file>\t\tPrint the worst-case stack depth "
+                 "from main\n"
+                 "          \t\t\tand from each interrupt handler and "
+                 "write it\n"
+                 "          \t\t\tto <file> as JSON. Recursion and "
+                 "indirect\n"
+                 "          \t\t\tcalls make it unbounded.\n";
+    std::cerr << "  -fheap-profile \t\tCall wrappers of malloc and free that "
+                 "record\n"
+                 "          \t\t\tlive and peak bytes per allocation "
+                 "site. The\n"
+                 "          \t\t\tprogram prints them when it exits.\n";
+    std::cerr << "  -fincremental-cache=<dir>\tCompile each function to an "
+                 "object file of\n"
+                 "          \t\t\tits own in <dir>. Unchanged functions "
+                 "are\n"
+                 "          \t\t\treused from there.\n";
+    std::cerr << "  -fincremental-cache-size=<MiB>\n"
+                 "          \t\t\tRemove the least recently used object "
+                 "files\n"
+                 "          \t\t\twhen the cache gets bigger (default: "
+                 "1024).\n";
+    std::cerr << "  -fno-discard-value-names \tKeep the names of local "
+                 "variables and\n"
+                 "          \t\t\tvalues in the generated IR.\n";
+    std::cerr << "  -ffunction-sections \t\tPlace each function in its own "
+                 "section.\n";
+    std::cerr << "  -fdata-sections \t\tPlace each global variable in its "
+                 "own section.\n"
+                 "          \t\t\tBoth are the default with -static and "
+                 "-mmcu,\n"
+                 "          \t\t\twhere the linker then discards unused "
+                 "sections.\n"
+                 "          \t\t\tUse -fno-function-sections and\n"
+                 "          \t\t\t-fno-data-sections to turn them off.\n";
+    std::cerr << "  -ffast-math \t\t\tAllow all floating-point optimizations "
+                 "that\n"
+                 "          \t\t\tignore IEEE semantics.\n";
+    std::cerr << "  -fassociative-math \t\tAllow reassociation of "
+                 "floating-point\n"
+                 "          \t\t\toperations, e.g. in reductions.\n";
+    std::cerr << "  -fno-honor-nans \t\tAssume that no operand or result "
+                 "is NaN.\n";
+    std::cerr << "  -ffp-contract=<mode>\t\tFuse a * b + c into one "
+                 "instruction:\n"
+                 "          \t\t\toff (default), on (within an "
+                 "expression),\n"
+                 "          \t\t\tor fast (whenever profitable).\n";
+    std::cerr << "  -Wperformance[=<bytes>]\tWarn about aggregates of at least "
+                 "<bytes>\n"
+                 "          \t\t\t(default: 128) that are passed or "
+                 "returned by\n"
+                 "          \t\t\tvalue or copied inside loops.\n";
     std::cerr << "  --print-ast \t\t\tPrint code represented by the AST.\n";
     std::cerr << "  --help \t\t\tDisplay this information.\n";
     /*
@@ -127,6 +232,7 @@ main(int argc, char *argv[])
     gen::FileType outputFileType = gen::OBJECT_FILE;
     std::string ldFlags;
     bool printAst = false;
+    bool preprocessOnly = false;
     bool codegen = true;
     bool createDep = false;
     bool createPhonyDep = false;
@@ -134,8 +240,20 @@ main(int argc, char *argv[])
     std::filesystem::path depFile;
     bool verbose = false;
     bool staticLink = false;
+    bool timeReport = false;
+    std::filesystem::path incrementalCache;
+    std::uintmax_t incrementalCacheMiB = 1024;
+    std::filesystem::path statsFile;
+    std::filesystem::path stackReportFile;
+    std::optional<bool> functionSections;
+    std::optional<bool> dataSections;
+    bool warnPerformance = false;
+    std::size_t performanceThreshold = 128;
     llvm::OptimizationLevel optLevel = llvm::OptimizationLevel::O0;
 
+    // names in the IR are only needed for reading it
+    gen::opt::discardValueNames = true;
+
     for (int i = 1; i < argc; ++i) {
 	if (!strcmp(argv[i], "-static")) {
 	    staticLink = true;
@@ -149,6 +267,47 @@ main(int argc, char *argv[])
 	    } else {
 		usage(argv[0]);
 	    }
+	} else if (!strcmp(argv[i], "-ftime-report")) {
+	    timeReport = true;
+	} else if (!strncmp(argv[i], "-fstats=", 8)) {
+	    statsFile = argv[i] + 8;
+	} else if (!strncmp(argv[i], "-fstack-report=", 15)) {
+	    stackReportFile = argv[i] + 15;
+	} else if (!strcmp(argv[i], "-fheap-profile")) {
+	    abc::CallExpr::enableHeapProfile(true);
+	} else if (!strncmp(argv[i], "-fincremental-cache=", 20)) {
+	    incrementalCache = argv[i] + 20;
+	} else if (!strncmp(argv[i], "-fincremental-cache-size=", 25)) {
+	    incrementalCacheMiB = std::strtoull(argv[i] + 25, nullptr, 10);
+	} else if (!strcmp(argv[i], "-fdiscard-value-names")) {
+	    gen::opt::discardValueNames = true;
+	} else if (!strcmp(argv[i], "-fno-discard-value-names")) {
+	    gen::opt::discardValueNames = false;
+	} else if (!strcmp(argv[i], "-ffunction-sections")) {
+	    functionSections = true;
+	} else if (!strcmp(argv[i], "-fno-function-sections")) {
+	    functionSections = false;
+	} else if (!strcmp(argv[i], "-fdata-sections")) {
+	    dataSections = true;
+	} else if (!strcmp(argv[i], "-fno-data-sections")) {
+	    dataSections = false;
+	} else if (!strcmp(argv[i], "-ffast-math")) {
+	    gen::opt::fastMath = true;
+	} else if (!strcmp(argv[i], "-fassociative-math")) {
+	    gen::opt::associativeMath = true;
+	} else if (!strcmp(argv[i], "-fno-honor-nans")) {
+	    gen::opt::honorNans = false;
+	} else if (!strcmp(argv[i], "-ffp-contract=off")) {
+	    gen::opt::fpContract = gen::opt::FP_CONTRACT_OFF;
+	} else if (!strcmp(argv[i], "-ffp-contract=on")) {
+	    gen::opt::fpContract = gen::opt::FP_CONTRACT_ON;
+	} else if (!strcmp(argv[i], "-ffp-contract=fast")) {
+	    gen::opt::fpContract = gen::opt::FP_CONTRACT_FAST;
+	} else if (!strcmp(argv[i], "-Wperformance")) {
+	    warnPerformance = true;
+	} else if (!strncmp(argv[i], "-Wperformance=", 14)) {
+	    warnPerformance = true;
+	    performanceThreshold = std::strtoull(argv[i] + 14, nullptr, 10);
 	} else if (!strncmp(argv[i], "-mmcu=", 6)) {
 	    std::string mcu = argv[i] + 6;
 	    gen::opt::mcu = mcu;
@@ -200,8 +359,10 @@ main(int argc, char *argv[])
 		break;
 	    case 'E':
 		printAst = true;
+		preprocessOnly = true;
 		abc::ImplicitCast::setOutput(false);
 		codegen = false;
+		createExecutable = false;
 		break;
 	    case 'S':
 		outputFileType = gen::ASSEMBLY_FILE;
@@ -285,6 +446,13 @@ main(int argc, char *argv[])
     }
     abc::lexer::addSearchPath(abcIncludeDir);
 
+    // static and MCU builds are linked with garbage collection of unused
+    // sections, which only pays off with one section per symbol
+    bool gcSections = staticLink || !gen::opt::mcu.empty();
+    gen::opt::functionSections = functionSections.value_or(gcSections);
+    gen::opt::dataSections = dataSections.value_or(gcSections);
+    abc::Symtab::keepLocalNames(!gen::opt::discardValueNames);
+
     if (infile.empty()) {
 	std::cerr << argv[0] << ": error: no input files\n";
 	std::exit(1);
@@ -311,6 +479,56 @@ main(int argc, char *argv[])
 	}
     }
 
+    // The AST is printed to stdout or, with '-E -o file', to file. Both are
+    // fully buffered: printing a large AST writes many small pieces.
+    std::ios::sync_with_stdio(false);
+    std::ostream *astOut = &std::cout;
+    std::ofstream astFile;
+    static char astFileBuf[1 << 16];
+    if (preprocessOnly && !outfile.empty()) {
+	astFile.rdbuf()->pubsetbuf(astFileBuf, sizeof(astFileBuf));
+	astFile.open(outfile);
+	if (!astFile) {
+	    std::cerr << argv[0] << ": error: can not open '"
+	              << outfile.c_str() << "'\n";
+	    std::exit(1);
+	}
+	astOut = &astFile;
+    }
+
+    // -fstack-report needs frame sizes from the backend, so every function
+    // has to be compiled (i.e. the incremental cache is not used)
+    if (!stackReportFile.empty() && outputFileType == gen::LLVM_FILE) {
+	std::cerr << argv[0]
+	          << ": error: -fstack-report can not be used with --emit-llvm\n";
+	std::exit(1);
+    }
+    std::ofstream stackReportOut;
+    bool firstStackReport = true;
+    if (!stackReportFile.empty()) {
+	stackReportOut.open(stackReportFile);
+	if (!stackReportOut) {
+	    std::cerr << argv[0] << ": error: can not open '"
+	              << stackReportFile.c_str() << "'\n";
+	    std::exit(1);
+	}
+	stackReportOut << "[";
+    }
+
+    // -fstats: one JSON object per compiled input file
+    std::ofstream statsOut;
+    bool firstStats = true;
+    if (!statsFile.empty()) {
+	statsOut.open(statsFile);
+	if (!statsOut) {
+	    std::cerr << argv[0] << ": error: can not open '"
+	              << statsFile.c_str() << "'\n";
+	    std::exit(1);
+	}
+	statsOut << "[";
+	llvm::EnableStatistics(false);
+    }
+
     bool useDefaultOutfile = outfile.empty();
     for (std::size_t i = 0; i < infile.size(); ++i) {
 	if (useDefaultOutfile) {
@@ -363,8 +581,18 @@ main(int argc, char *argv[])
 	    continue;
 	}
 
-	abc::initTypeSystem();
+	auto startTime = Clock::now();
+	double parseTime = 0, codegenTime = 0, backendTime = 0;
+	gen::IncrementalStats cacheStats;
+	abc::stats::reset();
+
+	// drop all state of the previous input file; strings are interned
+	// per file, so everything referring to them has to go first
+	abc::lexer::closeInputfiles();
+	abc::UStr::init();
+	// gen::init selects the widths of int, long and size_t for the target
 	gen::init(infile[i].stem().c_str(), optLevel);
+	abc::initTypeSystem();
 	abc::lexer::init();
 
 	if (!abc::lexer::openInputfile(infile[i].c_str())) {
@@ -398,21 +626,107 @@ main(int argc, char *argv[])
 	    std::cerr << infile[i].c_str();
 	    std::cerr << " -o " << outfile.c_str() << "\n";
 	}
+	auto phaseStart = Clock::now();
 	if (auto ast = abc::parser()) {
+	    parseTime = msSince(phaseStart);
+	    if (warnPerformance) {
+		abc::checkPerformance(ast.get(), performanceThreshold);
+	    }
 	    if (printAst) {
-		ast->print();
+		ast->print(*astOut);
 	    }
 	    if (codegen) {
+		phaseStart = Clock::now();
 		ast->codegen();
-		gen::print(outfile.c_str(), outputFileType);
+		codegenTime = msSince(phaseStart);
+		phaseStart = Clock::now();
+		if (stackReportOut.is_open()) {
+		    gen::recordFrameSizes();
+		}
+		if (!incrementalCache.empty() && !stackReportOut.is_open() &&
+		    outputFileType == gen::OBJECT_FILE) {
+		    auto part = gen::printIncremental(
+		        incrementalCache, outfile, incrementalCacheMiB << 20,
+		        cacheStats);
+		    std::string ldCmd = ccCmd + " -r -nostdlib -o ";
+		    ldCmd += outfile.c_str();
+		    for (const auto &obj : part) {
+			ldCmd += " ";
+			ldCmd += obj.c_str();
+		    }
+		    if (verbose) {
+			std::cerr << ldCmd.c_str() << "\n";
+		    }
+		    if (std::system(ldCmd.c_str())) {
+			std::cerr << "linker error\n";
+			std::exit(1);
+		    }
+		} else {
+		    gen::print(outfile.c_str(), outputFileType);
+		}
+		backendTime = msSince(phaseStart);
 		if (outputFileType == gen::OBJECT_FILE) {
 		    objFile.push_back(outfile);
 		}
+		if (stackReportOut.is_open()) {
+		    auto report = gen::analyzeStackDepth();
+		    std::cerr << "stack-report: file=" << infile[i].c_str()
+		              << "\n";
+		    gen::printStackReport(std::cerr, report);
+		    stackReportOut << (firstStackReport ? "\n" : ",\n")
+		                   << "  {\n"
+		                   << "    \"file\": ";
+		    abc::printJsonString(stackReportOut, infile[i].string());
+		    stackReportOut << ",\n";
+		    gen::printStackReportJson(stackReportOut, report, 4);
+		    stackReportOut << "\n  }";
+		    firstStackReport = false;
+		}
 	    }
 	} else {
 	    std::exit(1);
 	}
 
+	if (timeReport) {
+	    std::cerr << "time-report: file=" << infile[i].c_str()
+	              << " parse_ms=" << parseTime
+	              << " codegen_ms=" << codegenTime
+	              << " backend_ms=" << backendTime
+	              << " total_ms=" << msSince(startTime)
+	              << " maxrss_kb=" << maxRssKb();
+	    if (!incrementalCache.empty()) {
+		std::cerr << " cache_parts=" << cacheStats.numPart
+		          << " cache_hits=" << cacheStats.numHit;
+	    }
+	    std::cerr << "\n";
+	}
+
+	if (statsOut.is_open()) {
+	    // LLVM only collects statistics if it was built with assertions
+	    // or LLVM_FORCE_ENABLE_STATS, otherwise "backend" is empty
+	    std::string backend;
+	    llvm::raw_string_ostream backendOut{backend};
+	    llvm::PrintStatisticsJSON(backendOut);
+	    backendOut.flush();
+	    llvm::ResetStatistics();
+	    while (!backend.empty() && std::isspace(backend.back())) {
+		backend.pop_back();
+	    }
+
+	    statsOut << (firstStats ? "\n" : ",\n") << "  {\n"
+	             << "    \"file\": ";
+	    abc::printJsonString(statsOut, infile[i].string());
+	    statsOut << ",\n"
+	             << "    \"parse_ms\": " << parseTime << ",\n"
+	             << "    \"codegen_ms\": " << codegenTime << ",\n"
+	             << "    \"backend_ms\": " << backendTime << ",\n"
+	             << "    \"total_ms\": " << msSince(startTime) << ",\n"
+	             << "    \"frontend\": ";
+	    abc::stats::print(statsOut, 4);
+	    statsOut << ",\n    \"backend\": " << backend << "\n  }";
+	    firstStats = false;
+	}
+
 	if (createDep) {
 	    if (depFile.empty()) {
 		depFile = infile[i].stem().replace_extension("d");
@@ -439,6 +753,15 @@ main(int argc, char *argv[])
 	}
     }
 
+    if (statsOut.is_open()) {
+	statsOut << "\n]\n";
+	statsOut.close();
+    }
+    if (stackReportOut.is_open()) {
+	stackReportOut << "\n]\n";
+	stackReportOut.close();
+    }
+
     if (codegen && createExecutable) {
 	std::string linkerCmd = ccCmd + " -o ";
 	linkerCmd += executable.c_str();
@@ -453,6 +776,10 @@ main(int argc, char *argv[])
 	if (staticLink) {
 	    linkerCmd += " -static ";
 	}
+	if (gcSections) {
+	    linkerCmd += supportOs == "__Darwin__" ? " -Wl,-dead_strip "
+	                                           : " -Wl,--gc-sections ";
+	}
 
 	if (verbose) {
 	    // std::cerr << linkerCmd.c_str() << "\n";
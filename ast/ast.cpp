@@ -1,17 +1,23 @@
+#include <iomanip>
 #include <iostream>
 #include <unordered_map>
 
 #include "expr/compoundexpr.hpp"
 #include "expr/expr.hpp"
 #include "expr/implicitcast.hpp"
+#include "expr/labeladdress.hpp"
+#include "gen/constant.hpp"
 #include "gen/function.hpp"
 #include "gen/instruction.hpp"
 #include "gen/label.hpp"
 #include "gen/variable.hpp"
 #include "lexer/error.hpp"
 #include "type/enumtype.hpp"
+#include "type/integertype.hpp"
+#include "type/pointertype.hpp"
 #include "type/structtype.hpp"
 #include "type/typealias.hpp"
+#include "util/stats.hpp"
 
 #include "ast.hpp"
 
@@ -26,6 +32,15 @@ unusedFilter(UStr name)
     return name;
 }
 
+static std::ostream &
+indented(std::ostream &out, int indent)
+{
+    if (indent) {
+	out << std::setfill(' ') << std::setw(indent) << ' ';
+    }
+    return out;
+}
+
 static std::function<bool(Ast *)>
 createSetBreakLabel(gen::Label breakLabel)
 {
@@ -89,7 +104,9 @@ createSetGotoLabel(const std::unordered_map<UStr, gen::Label> &label)
 {
     return [&](Ast *ast) -> bool {
 	if (auto astLabel = dynamic_cast<AstGoto *>(ast)) {
-	    if (!label.contains(astLabel->labelName)) {
+	    if (astLabel->labelAddress) {
+		// indirect jump, target is only known at runtime
+	    } else if (!label.contains(astLabel->labelName)) {
 		error::location(astLabel->loc);
 		error::out() << error::setColor(error::BOLD) << astLabel->loc
 		             << ": " << error::setColor(error::BOLD_RED)
@@ -109,9 +126,15 @@ createSetGotoLabel(const std::unordered_map<UStr, gen::Label> &label)
 /*
  * Ast
  */
+Ast::Ast()
+{
+    stats::count(stats::AST_NODES);
+}
+
 void
 Ast::apply(std::function<bool(Ast *)> op)
 {
+    stats::count(stats::APPLY_VISITS);
     op(this);
 }
 
@@ -142,11 +165,11 @@ AstList::append(AstPtr &&ast)
 }
 
 void
-AstList::print(int indent) const
+AstList::print(std::ostream &out, int indent) const
 {
     for (const auto &n : node) {
-	n->print(indent);
-	error::out() << "\n";
+	n->print(out, indent);
+	out << "\n";
     }
 }
 
@@ -161,6 +184,7 @@ AstList::codegen()
 void
 AstList::apply(std::function<bool(Ast *)> op)
 {
+    stats::count(stats::APPLY_VISITS);
     if (op(this)) {
 	for (const auto &n : node) {
 	    n->apply(op);
@@ -171,6 +195,17 @@ AstList::apply(std::function<bool(Ast *)> op)
 /*
  * AstFunctionDecl
  */
+static void
+printParamType(std::ostream &out, const Type *fnType, std::size_t i)
+{
+    out << ": ";
+    if (fnType->paramIn()[i]) {
+	out << "in " << fnType->paramType()[i]->getConstRemoved();
+    } else {
+	out << fnType->paramType()[i];
+    }
+}
+
 AstFuncDecl::AstFuncDecl(lexer::Token fnName, const Type *fnType,
                          std::vector<lexer::Token> &&fnParamName,
                          bool externalLinkage)
@@ -202,27 +237,27 @@ AstFuncDecl::AstFuncDecl(lexer::Token fnName, const Type *fnType,
 }
 
 void
-AstFuncDecl::print(int indent) const
+AstFuncDecl::print(std::ostream &out, int indent) const
 {
-    error::out(indent) << (externalLinkage ? "extern " : "");
-    error::out() << "fn " << fnName.val << "(";
+    indented(out, indent) << (externalLinkage ? "extern " : "");
+    out << "fn " << fnName.val << "(";
     for (std::size_t i = 0; i < fnType->paramType().size(); ++i) {
 	if (i < fnParamName.size()) {
-	    error::out() << unusedFilter(fnParamName[i].val);
+	    out << unusedFilter(fnParamName[i].val);
 	}
-	error::out() << ": " << fnType->paramType()[i];
+	printParamType(out, fnType, i);
 	if (i + 1 < fnType->paramType().size()) {
-	    error::out() << ", ";
+	    out << ", ";
 	}
     }
     if (fnType->hasVarg()) {
-	error::out() << ", ...";
+	out << ", ...";
     }
-    error::out() << ")";
+    out << ")";
     if (!fnType->retType()->isVoid()) {
-	error::out() << ": " << fnType->retType();
+	out << ": " << fnType->retType();
     }
-    error::out() << ";";
+    out << ";";
 }
 
 void
@@ -235,8 +270,8 @@ AstFuncDecl::codegen()
 /*
  * AstFuncDef
  */
-AstFuncDef::AstFuncDef(lexer::Token fnName, const Type *fnType)
-    : fnName{fnName}, fnType{fnType}
+AstFuncDef::AstFuncDef(lexer::Token fnName, const Type *fnType, bool fastMath)
+    : fnName{fnName}, fnType{fnType}, fastMath{fastMath}
 {
     auto addDecl = Symtab::addDefinition(fnName.loc, fnName.val, fnType);
     assert(addDecl.first);
@@ -258,6 +293,9 @@ AstFuncDef::appendParamName(std::vector<lexer::Token> &&fnParamName_)
 	    fnParamName[i].loc, fnParamName[i].val, fnType->paramType()[i]);
 	assert(addDecl.first);
 	assert(addDecl.second);
+	if (fnType->paramIn()[i]) {
+	    addDecl.first->setInParam();
+	}
 	fnParamId.push_back(addDecl.first->getId().c_str());
     }
 }
@@ -265,8 +303,6 @@ AstFuncDef::appendParamName(std::vector<lexer::Token> &&fnParamName_)
 void
 AstFuncDef::appendBody(AstPtr &&body_)
 {
-    std::unordered_map<UStr, gen::Label> label;
-
     assert(!body);
     body = std::move(body_);
     body->apply(createSetReturnType(fnType->retType()));
@@ -274,30 +310,39 @@ AstFuncDef::appendBody(AstPtr &&body_)
     body->apply(createSetGotoLabel(label));
 }
 
+const std::vector<lexer::Token> &
+AstFuncDef::getParamName() const
+{
+    return fnParamName;
+}
+
 void
-AstFuncDef::print(int indent) const
+AstFuncDef::print(std::ostream &out, int indent) const
 {
-    error::out(indent) << "fn " << fnName.val << "(";
+    indented(out, indent) << "fn " << fnName.val << "(";
     for (std::size_t i = 0; i < fnType->paramType().size(); ++i) {
-	error::out() << unusedFilter(fnParamName[i].val);
-	error::out() << ": " << fnType->paramType()[i];
+	out << unusedFilter(fnParamName[i].val);
+	printParamType(out, fnType, i);
 	if (i + 1 < fnType->paramType().size()) {
-	    error::out() << ", ";
+	    out << ", ";
 	}
     }
     if (fnType->hasVarg()) {
-	error::out() << ", ...";
+	out << ", ...";
     }
-    error::out() << ")";
+    out << ")";
     if (!fnType->retType()->isVoid()) {
-	error::out() << ": " << fnType->retType();
+	out << ": " << fnType->retType();
+    }
+    if (fastMath) {
+	out << " fastmath";
     }
-    error::out() << "\n";
-    error::out(indent) << "{\n";
+    out << "\n";
+    indented(out, indent) << "{\n";
     if (body) {
-	body->print(indent + 4);
+	body->print(out, indent + 4);
     }
-    error::out(indent) << "}";
+    indented(out, indent) << "}";
 }
 
 void
@@ -306,7 +351,11 @@ AstFuncDef::codegen()
     if (!fnId.c_str()) {
 	return;
     }
-    gen::functionDefinitionBegin(fnId.c_str(), fnType, fnParamId, false);
+    gen::functionDefinitionBegin(fnId.c_str(), fnType, fnParamId, false,
+                                 fastMath);
+    for (const auto &[name, l] : label) {
+	gen::declareLabelName(name.c_str(), l);
+    }
     if (body) {
 	body->codegen();
     }
@@ -323,6 +372,15 @@ AstFuncDef::codegen()
     }
 }
 
+void
+AstFuncDef::apply(std::function<bool(Ast *)> op)
+{
+    stats::count(stats::APPLY_VISITS);
+    if (op(this) && body) {
+	body->apply(op);
+    }
+}
+
 /*
  * AstInitializerExpr
  */
@@ -333,10 +391,10 @@ AstInitializerExpr::AstInitializerExpr(const Type *destType, ExprPtr &&expr)
 }
 
 void
-AstInitializerExpr::print(int indent) const
+AstInitializerExpr::print(std::ostream &out, int indent) const
 {
     if (expr) {
-	error::out(indent) << expr;
+	indented(out, indent) << expr;
     }
 }
 
@@ -496,31 +554,65 @@ AstVar::setInternalLinkage()
 }
 
 void
-AstVar::print(int indent) const
+AstVar::setFoldedConstant()
 {
-    error::out(indent) << "";
+    auto initExpr = getInitializerExpr();
+    if (count() != 1 || !initExpr || !initExpr->isConst()) {
+	return;
+    }
+    auto ty = varType[0];
+    if (!ty->hasConstFlag() || !ty->isScalar() || ty->isFunction()) {
+	return;
+    }
+    // a label address is only a constant within its function
+    bool hasLabelAddress = false;
+    initExpr->apply([&](const Expr *e) {
+	hasLabelAddress =
+	    hasLabelAddress || dynamic_cast<const LabelAddress *>(e);
+	return !hasLabelAddress;
+    });
+    if (hasLabelAddress) {
+	return;
+    }
+    varEntry[0]->setConstExpr(initExpr);
+    // with an extern declaration other translation units expect a definition
+    // (an extern declaration can not follow the definition)
+    foldedConstant = !varEntry[0]->hasExternalLinkage();
+}
+
+bool
+AstVar::isFoldedConstant(std::size_t index) const
+{
+    assert(index < count());
+    return foldedConstant;
+}
+
+void
+AstVar::print(std::ostream &out, int indent) const
+{
+    indented(out, indent) << "";
     for (std::size_t i = 0; i < varName.size(); ++i) {
-	error::out() << varName[i].val;
+	out << varName[i].val;
 	if (i + 1 < varName.size()) {
-	    error::out(indent) << ", ";
+	    indented(out, indent) << ", ";
 	}
     }
-    error::out(indent) << ":";
+    indented(out, indent) << ":";
     if (varDeclType->isAuto()) {
-	error::out(indent) << "/*";
+	indented(out, indent) << "/*";
 	for (std::size_t i = 0; i < varName.size(); ++i) {
-	    error::out() << varType[i];
+	    out << varType[i];
 	    if (i + 1 < varName.size()) {
-		error::out(indent) << ", ";
+		indented(out, indent) << ", ";
 	    }
 	}
-	error::out(indent) << "*/";
+	indented(out, indent) << "*/";
     } else {
-	error::out(indent) << varDeclType;
+	indented(out, indent) << varDeclType;
     }
     if (initializerExpr) {
-	error::out() << " = ";
-	initializerExpr->print(0);
+	out << " = ";
+	initializerExpr->print(out, 0);
     }
 }
 
@@ -537,26 +629,26 @@ AstExternVar::AstExternVar(AstListPtr &&declList)
 }
 
 void
-AstExternVar::print(int indent) const
+AstExternVar::print(std::ostream &out, int indent) const
 {
-    error::out(indent) << "extern ";
+    indented(out, indent) << "extern ";
     if (declList->size() > 1) {
-	error::out() << "\n";
+	out << "\n";
 	for (std::size_t i = 0; const auto &decl : declList->node) {
 	    auto var = dynamic_cast<const AstVar *>(decl.get());
 	    assert(var);
-	    var->print(indent + 4);
+	    var->print(out, indent + 4);
 	    if (i + 1 < declList->size()) {
-		error::out() << ", ";
+		out << ", ";
 	    } else {
-		error::out() << "; ";
+		out << "; ";
 	    }
 	    ++i;
 	}
     } else {
 	auto var = dynamic_cast<const AstVar *>(declList->node[0].get());
-	var->print(0);
-	error::out() << "; ";
+	var->print(out, 0);
+	out << "; ";
     }
 }
 
@@ -593,30 +685,34 @@ AstExternVar::codegen()
 AstGlobalVar::AstGlobalVar(AstListPtr &&declList)
     : declList{std::move(declList)}
 {
+    for (auto &decl : this->declList->node) {
+	auto var = dynamic_cast<AstVar *>(decl.get());
+	var->setFoldedConstant();
+    }
 }
 
 void
-AstGlobalVar::print(int indent) const
+AstGlobalVar::print(std::ostream &out, int indent) const
 {
-    error::out(indent) << "global ";
+    indented(out, indent) << "global ";
     if (declList->size() > 1) {
-	error::out() << "\n";
+	out << "\n";
 	for (std::size_t i = 0; const auto &item : declList->node) {
 	    auto var = dynamic_cast<const AstVar *>(item.get());
-	    var->print(indent + 4);
+	    var->print(out, indent + 4);
 	    if (i + 1 < declList->size()) {
-		error::out() << ", ";
+		out << ", ";
 	    } else {
-		error::out() << "; ";
+		out << "; ";
 	    }
 	    ++i;
 	}
     } else {
 	auto var = dynamic_cast<const AstVar *>(declList->node[0].get());
-	var->print(0);
-	error::out() << "; ";
+	var->print(out, 0);
+	out << "; ";
     }
-    error::out() << "\n";
+    out << "\n";
 }
 
 void
@@ -624,7 +720,9 @@ AstGlobalVar::codegen()
 {
     for (const auto &item : declList->node) {
 	auto var = dynamic_cast<const AstVar *>(item.get());
-	if (var->count() == 1) {
+	if (var->count() == 1 && var->isFoldedConstant(0)) {
+	    continue;
+	} else if (var->count() == 1) {
 	    gen::globalVariableDefinition(var->getId(0).c_str(),
 	                                  var->getType(0));
 	} else {
@@ -650,7 +748,9 @@ AstGlobalVar::codegen()
 	                 << error::setColor(error::NORMAL);
 	    error::fatal();
 	}
-	if (var->count() == 1) {
+	if (var->count() == 1 && var->isFoldedConstant(0)) {
+	    continue;
+	} else if (var->count() == 1) {
 	    auto initialValue =
 	        initializer ? initializer->loadConstant() : nullptr;
 	    gen::globalVariableDefinition(var->getId(0).c_str(),
@@ -681,27 +781,27 @@ AstStaticVar::AstStaticVar(AstListPtr &&declList)
 }
 
 void
-AstStaticVar::print(int indent) const
+AstStaticVar::print(std::ostream &out, int indent) const
 {
-    error::out(indent) << "static ";
+    indented(out, indent) << "static ";
     if (declList->size() > 1) {
-	error::out() << "\n";
+	out << "\n";
 	for (std::size_t i = 0; const auto &item : declList->node) {
 	    auto var = dynamic_cast<const AstVar *>(item.get());
-	    var->print(indent + 4);
+	    var->print(out, indent + 4);
 	    if (i + 1 < declList->size()) {
-		error::out() << ", ";
+		out << ", ";
 	    } else {
-		error::out() << "; ";
+		out << "; ";
 	    }
 	    ++i;
 	}
     } else {
 	auto var = dynamic_cast<const AstVar *>(declList->node[0].get());
-	var->print(0);
-	error::out() << "; ";
+	var->print(out, 0);
+	out << "; ";
     }
-    error::out() << "\n";
+    out << "\n";
 }
 
 void
@@ -757,25 +857,36 @@ AstLocalVar::AstLocalVar(AstListPtr &&declList) : declList{std::move(declList)}
 }
 
 void
-AstLocalVar::print(int indent) const
+AstLocalVar::print(std::ostream &out, int indent) const
 {
-    error::out(indent) << "local ";
+    indented(out, indent) << "local ";
     if (declList->size() > 1) {
 	for (std::size_t i = 0; const auto &item : declList->node) {
-	    error::out() << "\n";
+	    out << "\n";
 	    auto var = dynamic_cast<const AstVar *>(item.get());
-	    var->print(indent + 4);
+	    var->print(out, indent + 4);
 	    if (i + 1 < declList->size()) {
-		error::out() << ", ";
+		out << ", ";
 	    } else {
-		error::out() << "; ";
+		out << "; ";
 	    }
 	    ++i;
 	}
     } else {
 	auto var = dynamic_cast<const AstVar *>(declList->node[0].get());
-	var->print(0);
-	error::out() << "; ";
+	var->print(out, 0);
+	out << "; ";
+    }
+}
+
+// packed arrays and structures with bit-fields have no compound initializer,
+// so without an initializer they start zeroed instead of with indeterminate
+// padding bits
+static void
+zeroInitialize(const char *id, const Type *type)
+{
+    if (type->isPackedBoolArray() || type->hasBitFields()) {
+	gen::store(gen::getConstantZero(type), gen::loadAddress(id));
     }
 }
 
@@ -792,6 +903,8 @@ AstLocalVar::codegen()
 	    if (initializer) {
 		gen::store(initializer->loadValue(),
 		           gen::loadAddress(var->getId(0).c_str()));
+	    } else {
+		zeroInitialize(var->getId(0).c_str(), var->getType(0));
 	    }
 	} else {
 	    auto compExpr = dynamic_cast<const CompoundExpr *>(initializer);
@@ -804,6 +917,8 @@ AstLocalVar::codegen()
 		if (initializer) {
 		    gen::store(compExpr->loadValue(i),
 		               gen::loadAddress(var->getId(i).c_str()));
+		} else {
+		    zeroInitialize(var->getId(i).c_str(), var->getType(i));
 		}
 	    }
 	}
@@ -819,13 +934,13 @@ AstReturn::AstReturn(lexer::Loc loc, ExprPtr &&expr)
 }
 
 void
-AstReturn::print(int indent) const
+AstReturn::print(std::ostream &out, int indent) const
 {
-    error::out(indent) << "return";
+    indented(out, indent) << "return";
     if (expr) {
-	error::out() << " " << expr;
+	out << " " << expr;
     }
-    error::out() << ";";
+    out << ";";
 }
 
 void
@@ -873,16 +988,38 @@ AstGoto::AstGoto(lexer::Loc loc, UStr labelName)
 {
 }
 
+AstGoto::AstGoto(lexer::Loc loc, ExprPtr &&labelAddress)
+    : loc{loc}, labelAddress{std::move(labelAddress)}
+{
+    assert(this->labelAddress);
+    if (!this->labelAddress->type->isPointer()) {
+	error::location(this->labelAddress->loc);
+	error::out() << error::setColor(error::BOLD)
+	             << this->labelAddress->loc << ": "
+	             << error::setColor(error::BOLD_RED)
+	             << "error: " << error::setColor(error::BOLD)
+	             << "indirect goto requires a pointer, e.g. '&&label'\n"
+	             << error::setColor(error::NORMAL);
+	error::fatal();
+    }
+}
+
 void
-AstGoto::print(int indent) const
+AstGoto::print(std::ostream &out, int indent) const
 {
-    error::out(indent) << "goto " << labelName.c_str() << ";";
+    if (labelAddress) {
+	indented(out, indent) << "goto *" << labelAddress << ";";
+    } else {
+	indented(out, indent) << "goto " << labelName.c_str() << ";";
+    }
 }
 
 void
 AstGoto::codegen()
 {
-    if (!label) {
+    if (labelAddress) {
+	gen::indirectJumpInstruction(labelAddress->loadValue());
+    } else if (!label) {
 	error::location(loc);
 	error::out() << error::setColor(error::BOLD) << loc << ": "
 	             << error::setColor(error::BOLD_RED)
@@ -905,9 +1042,9 @@ AstLabel::AstLabel(lexer::Loc loc, UStr labelName)
 }
 
 void
-AstLabel::print(int indent) const
+AstLabel::print(std::ostream &out, int indent) const
 {
-    error::out(indent) << "label " << labelName.c_str() << ":";
+    indented(out, indent) << "label " << labelName.c_str() << ":";
 }
 
 void
@@ -922,9 +1059,9 @@ AstLabel::codegen()
 AstBreak::AstBreak(lexer::Loc loc) : loc{loc} {}
 
 void
-AstBreak::print(int indent) const
+AstBreak::print(std::ostream &out, int indent) const
 {
-    error::out(indent) << "break;";
+    indented(out, indent) << "break;";
 }
 
 void
@@ -949,9 +1086,9 @@ AstBreak::codegen()
 AstContinue::AstContinue(lexer::Loc loc) : loc{loc} {}
 
 void
-AstContinue::print(int indent) const
+AstContinue::print(std::ostream &out, int indent) const
 {
-    error::out(indent) << "continue;";
+    indented(out, indent) << "continue;";
 }
 
 void
@@ -976,12 +1113,12 @@ AstContinue::codegen()
 AstExpr::AstExpr(ExprPtr &&expr) : expr(std::move(expr)) {}
 
 void
-AstExpr::print(int indent) const
+AstExpr::print(std::ostream &out, int indent) const
 {
     if (expr) {
-	error::out(indent) << expr << ";";
+	indented(out, indent) << expr << ";";
     } else {
-	error::out(indent) << ";";
+	indented(out, indent) << ";";
     }
 }
 
@@ -1015,40 +1152,40 @@ AstIf::AstIf(lexer::Loc loc, ExprPtr &&cond, AstPtr &&thenBody,
 }
 
 void
-AstIf::print(int indent) const
+AstIf::print(std::ostream &out, int indent) const
 {
-    error::out(indent) << "if (" << cond << ") {\n";
-    thenBody->print(indent + 4);
+    indented(out, indent) << "if (" << cond << ") {\n";
+    thenBody->print(out, indent + 4);
     if (elseBody) {
 	if (auto astIf = dynamic_cast<const AstIf *>(elseBody.get())) {
-	    error::out(indent) << "} else ";
-	    astIf->printElseIfCase(indent);
+	    indented(out, indent) << "} else ";
+	    astIf->printElseIfCase(out, indent);
 	} else {
-	    error::out(indent) << "} else {\n";
-	    elseBody->print(indent + 4);
-	    error::out(indent) << "}";
+	    indented(out, indent) << "} else {\n";
+	    elseBody->print(out, indent + 4);
+	    indented(out, indent) << "}";
 	}
     } else {
-	error::out(indent) << "}";
+	indented(out, indent) << "}";
     }
 }
 
 void
-AstIf::printElseIfCase(int indent) const
+AstIf::printElseIfCase(std::ostream &out, int indent) const
 {
-    error::out() << "if (" << cond << ") {\n";
-    thenBody->print(indent + 4);
+    out << "if (" << cond << ") {\n";
+    thenBody->print(out, indent + 4);
     if (elseBody) {
 	if (auto astIf = dynamic_cast<const AstIf *>(elseBody.get())) {
-	    error::out(indent) << "} else ";
-	    astIf->printElseIfCase(indent);
+	    indented(out, indent) << "} else ";
+	    astIf->printElseIfCase(out, indent);
 	} else {
-	    error::out(indent) << "} else {\n";
-	    elseBody->print(indent + 4);
-	    error::out(indent) << "}";
+	    indented(out, indent) << "} else {\n";
+	    elseBody->print(out, indent + 4);
+	    indented(out, indent) << "}";
 	}
     } else {
-	error::out(indent) << "}";
+	indented(out, indent) << "}";
     }
 }
 
@@ -1090,6 +1227,7 @@ AstIf::codegen()
 void
 AstIf::apply(std::function<bool(Ast *)> op)
 {
+    stats::count(stats::APPLY_VISITS);
     if (op(this)) {
 	thenBody->apply(op);
 	if (elseBody) {
@@ -1193,25 +1331,25 @@ AstSwitch::complete()
 }
 
 void
-AstSwitch::print(int indent) const
+AstSwitch::print(std::ostream &out, int indent) const
 {
-    error::out(indent) << "switch (" << expr << ") {\n";
+    indented(out, indent) << "switch (" << expr << ") {\n";
     for (std::size_t i = 0, casePosIndex = 0; i < body.size(); ++i) {
 	if ((!casePos.size() || (casePos.size() && i < casePos[0])) &&
 	    (!hasDefault || (hasDefault && i < defaultPos))) {
-	    error::out(indent + 4) << "// never reached\n";
+	    indented(out, indent + 4) << "// never reached\n";
 	}
 	while (casePosIndex < casePos.size() && i == casePos[casePosIndex]) {
-	    error::out(indent + 4)
+	    indented(out, indent + 4)
 	        << "case " << caseExpr[casePosIndex++] << ":\n";
 	}
 	if (hasDefault && i == defaultPos) {
-	    error::out(indent + 4) << "default:\n";
+	    indented(out, indent + 4) << "default:\n";
 	}
-	body.node[i]->print(indent + 8);
-	error::out() << "\n";
+	body.node[i]->print(out, indent + 8);
+	out << "\n";
     }
-    error::out(indent) << "}";
+    indented(out, indent) << "}";
 }
 
 void
@@ -1254,6 +1392,7 @@ AstSwitch::codegen()
 void
 AstSwitch::apply(std::function<bool(Ast *)> op)
 {
+    stats::count(stats::APPLY_VISITS);
     body.apply(op);
 }
 
@@ -1266,11 +1405,11 @@ AstWhile::AstWhile(ExprPtr &&cond, AstPtr &&body)
 }
 
 void
-AstWhile::print(int indent) const
+AstWhile::print(std::ostream &out, int indent) const
 {
-    error::out(indent) << "while (" << cond << ") {\n";
-    body->print(indent + 4);
-    error::out(indent) << "}";
+    indented(out, indent) << "while (" << cond << ") {\n";
+    body->print(out, indent + 4);
+    indented(out, indent) << "}";
 }
 
 void
@@ -1296,6 +1435,7 @@ AstWhile::codegen()
 void
 AstWhile::apply(std::function<bool(Ast *)> op)
 {
+    stats::count(stats::APPLY_VISITS);
     if (op(this)) {
 	body->apply(op);
     }
@@ -1310,11 +1450,11 @@ AstDoWhile::AstDoWhile(ExprPtr &&cond, AstPtr &&body)
 }
 
 void
-AstDoWhile::print(int indent) const
+AstDoWhile::print(std::ostream &out, int indent) const
 {
-    error::out(indent) << "do {\n";
-    body->print(indent + 4);
-    error::out(indent) << "} while (" << cond << ");";
+    indented(out, indent) << "do {\n";
+    body->print(out, indent + 4);
+    indented(out, indent) << "} while (" << cond << ");";
 }
 
 void
@@ -1339,6 +1479,7 @@ AstDoWhile::codegen()
 void
 AstDoWhile::apply(std::function<bool(Ast *)> op)
 {
+    stats::count(stats::APPLY_VISITS);
     if (op(this)) {
 	body->apply(op);
     }
@@ -1358,6 +1499,45 @@ AstFor::AstFor(AstPtr &&init, ExprPtr &&cond, ExprPtr &&update)
 {
 }
 
+AstFor::AstFor(lexer::Token index, lexer::Token element, ExprPtr &&range)
+    : rangeIndex{index}, rangeElement{element}, range{std::move(range)}
+{
+    auto rangeType = this->range->type;
+    rangeByPointer = rangeType->isPointer() && rangeType->refType()->isArray();
+    auto arrayType = rangeByPointer ? rangeType->refType() : rangeType;
+    if (!arrayType->isArray() || arrayType->isUnboundArray() ||
+        (!rangeByPointer && !this->range->hasAddress())) {
+	error::location(this->range->loc);
+	error::out() << error::setColor(error::BOLD) << this->range->loc
+	             << ": " << error::setColor(error::BOLD_RED)
+	             << "error: " << error::setColor(error::BOLD)
+	             << "range has to be an array with known dimension or a "
+	             << "pointer to such an array\n"
+	             << error::setColor(error::NORMAL);
+	error::fatal();
+    }
+    // a range over a pointer to an array yields pointers to its elements
+    rangeElementType = rangeByPointer
+                           ? PointerType::create(arrayType->refType())
+                           : arrayType->refType();
+
+    auto sizeType = IntegerType::createSizeType();
+    if (rangeIndex.kind != lexer::TokenKind::BAD) {
+	auto addDecl = Symtab::addDefinition(rangeIndex.loc, rangeIndex.val,
+	                                     sizeType->getConst());
+	assert(addDecl.first);
+	rangeIndexId = addDecl.first->getId();
+    }
+    auto addDecl = Symtab::addDefinition(rangeElement.loc, rangeElement.val,
+                                         rangeElementType);
+    assert(addDecl.first);
+    rangeElementId = addDecl.first->getId();
+    if (rangeIndexId.empty()) {
+	// not visible in the program, only the induction variable
+	rangeIndexId = UStr::create(std::string{rangeElementId.c_str()} + ".i");
+    }
+}
+
 void
 AstFor::appendBody(AstPtr &&body_)
 {
@@ -1365,30 +1545,43 @@ AstFor::appendBody(AstPtr &&body_)
 }
 
 void
-AstFor::print(int indent) const
+AstFor::print(std::ostream &out, int indent) const
 {
-    error::out(indent) << "for (";
+    indented(out, indent) << "for (";
+    if (range) {
+	if (rangeIndex.kind != lexer::TokenKind::BAD) {
+	    out << rangeIndex.val << ", ";
+	}
+	out << rangeElement.val << " in " << range << ") {\n";
+	body->print(out, indent + 4);
+	indented(out, indent) << "}";
+	return;
+    }
     if (initAst) {
-	initAst->print(0);
+	initAst->print(out, 0);
     } else if (initExpr) {
-	error::out() << initExpr;
-	error::out() << "; ";
+	out << initExpr;
+	out << "; ";
     }
     if (cond) {
-	error::out() << cond;
+	out << cond;
     }
-    error::out() << "; ";
+    out << "; ";
     if (update) {
-	error::out() << update;
+	out << update;
     }
-    error::out() << ") {\n";
-    body->print(indent + 4);
-    error::out(indent) << "}";
+    out << ") {\n";
+    body->print(out, indent + 4);
+    indented(out, indent) << "}";
 }
 
 void
 AstFor::codegen()
 {
+    if (range) {
+	codegenRange();
+	return;
+    }
     auto condLabel = gen::getLabel("cond");
     auto loopLabel = gen::getLabel("loop");
     auto endLabel = gen::getLabel("end");
@@ -1417,9 +1610,59 @@ AstFor::codegen()
     gen::defineLabel(endLabel);
 }
 
+// The induction variable has type size_t and runs from 0 to the dimension of
+// the array, so element addresses are inbounds GEPs and the loop has a known
+// trip count.
+void
+AstFor::codegenRange()
+{
+    auto condLabel = gen::getLabel("cond");
+    auto loopLabel = gen::getLabel("loop");
+    auto nextLabel = gen::getLabel("next");
+    auto endLabel = gen::getLabel("end");
+
+    body->apply(createSetBreakLabel(endLabel));
+    body->apply(createSetContinueLabel(nextLabel));
+
+    auto arrayType = rangeByPointer ? range->type->refType() : range->type;
+    auto elementType = arrayType->refType();
+    auto sizeType = IntegerType::createSizeType();
+
+    auto base = rangeByPointer ? range->loadValue() : range->loadAddress();
+    auto indexAddr =
+        gen::localVariableDefinition(rangeIndexId.c_str(), sizeType);
+    auto elementAddr =
+        gen::localVariableDefinition(rangeElementId.c_str(), rangeElementType);
+    gen::store(gen::getConstantZero(sizeType), indexAddr);
+
+    gen::defineLabel(condLabel);
+    auto index = gen::fetch(indexAddr, sizeType);
+    auto dim = gen::getConstantInt(arrayType->dim(), sizeType);
+    gen::jumpInstruction(gen::instruction(gen::ULT, index, dim), loopLabel,
+                         endLabel);
+
+    gen::defineLabel(loopLabel);
+    auto addr = gen::pointerIncrement(elementType, base, index, true);
+    gen::store(rangeByPointer ? addr : gen::fetch(addr, elementType),
+               elementAddr);
+    body->codegen();
+
+    gen::defineLabel(nextLabel);
+    index = gen::fetch(indexAddr, sizeType);
+    gen::store(gen::instruction(gen::ADD, index,
+                                gen::getConstantInt(1, sizeType)),
+               indexAddr);
+    gen::jumpInstruction(condLabel);
+
+    gen::defineLabel(endLabel);
+}
+
 void
 AstFor::apply(std::function<bool(Ast *)> op)
 {
+    stats::count(stats::APPLY_VISITS);
+    // like for the other statements, 'op' gets the expressions of the loop
+    // header ('cond', 'update' and 'range') through this node
     if (op(this)) {
 	body->apply(op);
     }
@@ -1463,9 +1706,9 @@ AstTypeDecl::AstTypeDecl(lexer::Token name, const Type *type)
 }
 
 void
-AstTypeDecl::print(int indent) const
+AstTypeDecl::print(std::ostream &out, int indent) const
 {
-    error::out(indent) << "type " << name.val << ":" << type << ";";
+    indented(out, indent) << "type " << name.val << ":" << type << ";";
 }
 
 /*
@@ -1558,34 +1801,34 @@ AstEnumDecl::complete()
 }
 
 void
-AstEnumDecl::print(int indent) const
+AstEnumDecl::print(std::ostream &out, int indent) const
 {
     if (!enumConstant.size()) {
-	error::out(indent) << "enum " << enumTypeName.val;
+	indented(out, indent) << "enum " << enumTypeName.val;
 	if (intType) {
-	    error::out() << ": " << intType;
+	    out << ": " << intType;
 	}
-	error::out() << ";\n";
+	out << ";\n";
     } else {
-	error::out(indent) << "enum " << enumTypeName.val;
+	indented(out, indent) << "enum " << enumTypeName.val;
 	if (intType) {
-	    error::out() << ": " << intType;
+	    out << ": " << intType;
 	}
-	error::out() << "\n";
-	error::out(indent) << "{\n";
+	out << "\n";
+	indented(out, indent) << "{\n";
 	for (std::size_t i = 0; i < enumConstant.size(); ++i) {
-	    error::out(indent + 4) << enumConstant[i];
+	    indented(out, indent + 4) << enumConstant[i];
 	    if (enumExpr[i]) {
-		error::out() << " = " << enumExpr[i];
+		out << " = " << enumExpr[i];
 	    }
-	    error::out() << ", // ";
+	    out << ", // ";
 	    if (intType->isSignedInteger()) {
-		error::out() << enumConstant[i]->getSignedIntValue() << "\n";
+		out << enumConstant[i]->getSignedIntValue() << "\n";
 	    } else {
-		error::out() << enumConstant[i]->getUnsignedIntValue() << "\n";
+		out << enumConstant[i]->getUnsignedIntValue() << "\n";
 	    }
 	}
-	error::out(indent) << "};";
+	indented(out, indent) << "};";
     }
 }
 
@@ -1635,12 +1878,13 @@ AstStructDecl::AstStructDecl(lexer::Token name) : structTypeName{name}
 void
 AstStructDecl::add(std::vector<lexer::Token> &&memberName,
                    std::vector<std::size_t> &&memberIndex,
-                   const Type *memberType)
+                   const Type *memberType, std::size_t bitWidth)
 {
     assert(memberType);
     memberDecl.push_back({std::move(memberName), memberType});
     for (auto index : memberIndex) {
 	this->memberIndex.push_back(index);
+	memberBitWidth.push_back(bitWidth);
     }
 }
 
@@ -1652,6 +1896,7 @@ AstStructDecl::add(std::vector<lexer::Token> &&memberName,
     memberDecl.push_back({std::move(memberName), std::move(memberType)});
     for (auto index : memberIndex) {
 	this->memberIndex.push_back(index);
+	memberBitWidth.push_back(0);
     }
 }
 
@@ -1700,7 +1945,8 @@ AstStructDecl::complete()
 
     structType->complete(std::move(memberName),
                          std::vector<std::size_t>{memberIndex},
-                         std::move(memberType));
+                         std::move(memberType),
+                         std::vector<std::size_t>{memberBitWidth});
 }
 
 const Type *
@@ -1710,49 +1956,54 @@ AstStructDecl::getStructType() const
 }
 
 void
-AstStructDecl::print(int indent) const
+AstStructDecl::print(std::ostream &out, int indent) const
 {
     if (!memberDecl.size()) {
-	error::out(indent) << "struct " << structTypeName.val << ";";
+	indented(out, indent) << "struct " << structTypeName.val << ";";
     } else {
-	error::out(indent) << "struct " << structTypeName.val << "\n";
-	error::out(indent) << "{\n";
+	indented(out, indent) << "struct " << structTypeName.val << "\n";
+	indented(out, indent) << "{\n";
 
 	std::size_t pos = 0;
 	bool unionSection = false;
 	for (const auto &decl : memberDecl) {
 	    bool lastPos = pos + 1 == memberIndex.size();
-	    if (!unionSection) {
+	    auto bitWidth = memberBitWidth[pos];
+	    if (!unionSection && !bitWidth) {
 		if (!lastPos && memberIndex[pos] == memberIndex[pos + 1]) {
 		    unionSection = true;
 		    indent += 4;
-		    error::out(indent) << "union {\n";
+		    indented(out, indent) << "union {\n";
 		}
 	    }
-	    error::out(indent + 4) << "";
+	    indented(out, indent + 4) << "";
 	    for (std::size_t i = 0; i < decl.first.size(); ++i, ++pos) {
-		error::out() << decl.first[i].val;
+		out << decl.first[i].val;
 		if (i + 1 < decl.first.size()) {
-		    error::out() << ", ";
+		    out << ", ";
 		}
 	    }
-	    error::out() << ": ";
+	    out << ": ";
 	    if (std::holds_alternative<const Type *>(decl.second)) {
-		error::out() << std::get<const Type *>(decl.second) << ";\n";
+		out << std::get<const Type *>(decl.second);
+		if (bitWidth) {
+		    out << " : " << bitWidth;
+		}
+		out << ";\n";
 	    } else {
-		error::out() << "\n";
-		std::get<AstPtr>(decl.second)->print(indent + 8);
-		error::out() << "\n";
+		out << "\n";
+		std::get<AstPtr>(decl.second)->print(out, indent + 8);
+		out << "\n";
 	    }
 	    if (unionSection) {
 		if (lastPos || (memberIndex[pos - 1] != memberIndex[pos])) {
 		    unionSection = false;
-		    error::out(indent) << "};\n";
+		    indented(out, indent) << "};\n";
 		    indent -= 4;
 		}
 	    }
 	}
-	error::out(indent) << "};";
+	indented(out, indent) << "};";
     }
 }
 
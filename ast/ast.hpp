@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <memory>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -18,10 +19,10 @@ namespace abc {
 class Ast
 {
     public:
-	Ast() = default;
+	Ast();
 	virtual ~Ast() = default;
 
-	virtual void print(int indent = 0) const = 0;
+	virtual void print(std::ostream &out, int indent = 0) const = 0;
 	virtual void codegen();
 	virtual void apply(std::function<bool(Ast *)> op);
 	virtual const Type *type() const;
@@ -40,7 +41,7 @@ class AstList : public Ast
 
 	std::size_t size() const;
 	void append(AstPtr &&ast);
-	void print(int indent = 0) const override;
+	void print(std::ostream &out, int indent = 0) const override;
 	void codegen() override;
 	void apply(std::function<bool(Ast *)> op) override;
 };
@@ -62,7 +63,7 @@ class AstFuncDecl : public Ast
 	const bool externalLinkage;
 	UStr fnId;
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 	void codegen() override;
 };
 
@@ -74,20 +75,25 @@ class AstFuncDef : public Ast
 	std::vector<lexer::Token> fnParamName;
 	std::vector<const char *> fnParamId;
 	AstPtr body;
+	std::unordered_map<UStr, gen::Label> label;
 
     public:
-	AstFuncDef(lexer::Token fnName, const Type *fnType);
+	AstFuncDef(lexer::Token fnName, const Type *fnType,
+	           bool fastMath = false);
 
 	const lexer::Token fnName;
 	const Type * const fnType;
+	const bool fastMath;
 	UStr fnId;
 
 
 	void appendParamName(std::vector<lexer::Token> &&fnParamName);
 	void appendBody(AstPtr &&body);
+	const std::vector<lexer::Token> &getParamName() const;
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 	void codegen() override;
+	void apply(std::function<bool(Ast *)> op) override;
 };
 
 //------------------------------------------------------------------------------
@@ -98,7 +104,7 @@ class AstInitializerExpr : public Ast
 	AstInitializerExpr(const Type *destType, ExprPtr &&expr);
 	const ExprPtr expr;
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 };
 
 using AstInitializerExprPtr = std::unique_ptr<AstInitializerExpr>;
@@ -111,10 +117,12 @@ class AstVar : public Ast
 	AstInitializerExprPtr initializerExpr;
 	void init(bool define);
 
+        // only valid while parsing, the entries belong to the symbol table
         std::vector<symtab::Entry *> varEntry;
         std::vector<UStr> varId;
         std::vector<const Type *> varType;
 	const Type *varDeclType;
+	bool foldedConstant = false;
 
     public:
 	AstVar(lexer::Token varName, lexer::Loc varTypeLoc,
@@ -136,7 +144,13 @@ class AstVar : public Ast
         void setInternalLinkage();
         void setLinkage();
 
-	void print(int indent) const override;
+        // for global constants with a scalar type and a constant initializer:
+        // uses are folded and the variable is only defined if its address is
+        // taken
+        void setFoldedConstant();
+        bool isFoldedConstant(std::size_t index) const;
+
+	void print(std::ostream &out, int indent) const override;
 };
 
 using AstVarPtr = std::unique_ptr<AstVar>;
@@ -150,7 +164,7 @@ class AstExternVar : public Ast
 
 	const AstListPtr declList;
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 	void codegen() override;
 };
 
@@ -163,7 +177,7 @@ class AstGlobalVar : public Ast
 
 	const AstListPtr declList;
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 	void codegen() override;
 };
 
@@ -176,7 +190,7 @@ class AstStaticVar : public Ast
 
 	const AstListPtr declList;
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 	void codegen() override;
 };
 
@@ -189,7 +203,7 @@ class AstLocalVar : public Ast
 
 	const AstListPtr declList;
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 	void codegen() override;
 };
 
@@ -204,7 +218,7 @@ class AstReturn : public Ast
 	ExprPtr expr;
 	const Type *retType = nullptr;
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 	void codegen() override;
 };
 
@@ -218,7 +232,7 @@ class AstBreak : public Ast
 	const lexer::Loc loc;
 	gen::Label label = nullptr;
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 	void codegen() override;
 };
 
@@ -232,7 +246,7 @@ class AstContinue : public Ast
 	const lexer::Loc loc;
 	gen::Label label = nullptr;
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 	void codegen() override;
 };
 
@@ -242,12 +256,14 @@ class AstGoto : public Ast
 {
     public:
 	AstGoto(lexer::Loc loc, UStr labelName);
+	AstGoto(lexer::Loc loc, ExprPtr &&labelAddress);
 
 	const lexer::Loc loc;
 	UStr labelName;
 	gen::Label label = nullptr;
+	const ExprPtr labelAddress; // for 'goto *expr'
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 	void codegen() override;
 };
 
@@ -262,7 +278,7 @@ class AstLabel : public Ast
 	UStr labelName;
 	gen::Label label = nullptr;
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 	void codegen() override;
 };
 
@@ -275,7 +291,7 @@ class AstExpr : public Ast
 
 	ExprPtr expr;
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 	void codegen() override;
 };
 
@@ -293,8 +309,8 @@ class AstIf : public Ast
 	const AstPtr thenBody;
 	const AstPtr elseBody;
 
-	void print(int indent) const override;
-	void printElseIfCase(int indent) const;
+	void print(std::ostream &out, int indent) const override;
+	void printElseIfCase(std::ostream &out, int indent) const;
 	void codegen() override;
 	void apply(std::function<bool(Ast *)> op) override;
 };
@@ -320,7 +336,7 @@ class AstSwitch : public Ast
 	void append(AstPtr &&stmt);
 	void complete();
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 	void codegen() override;
 	void apply(std::function<bool(Ast *)> op) override;
 };
@@ -335,7 +351,7 @@ class AstWhile : public Ast
 	const ExprPtr cond;
 	const AstPtr body;
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 	void codegen() override;
 	void apply(std::function<bool(Ast *)> op) override;
 };
@@ -350,7 +366,7 @@ class AstDoWhile : public Ast
 	const ExprPtr cond;
 	const AstPtr body;
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 	void codegen() override;
 	void apply(std::function<bool(Ast *)> op) override;
 };
@@ -361,18 +377,28 @@ class AstFor : public Ast
 {
     private:
 	AstPtr body;
+	UStr rangeIndexId, rangeElementId;
+	const Type *rangeElementType = nullptr;
+	bool rangeByPointer = false;
+
+	void codegenRange();
 
     public:
 	AstFor(ExprPtr &&init, ExprPtr &&cond, ExprPtr &&update);
 	AstFor(AstPtr &&init, ExprPtr &&cond, ExprPtr &&update);
+	// for (index, element in range): 'index' is optional (kind BAD)
+	AstFor(lexer::Token index, lexer::Token element, ExprPtr &&range);
 
 	const AstPtr initAst;
 	const ExprPtr initExpr;
 	const ExprPtr cond, update;
 
+	const lexer::Token rangeIndex, rangeElement;
+	const ExprPtr range;
+
 	void appendBody(AstPtr &&body);
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 	void codegen() override;
 	void apply(std::function<bool(Ast *)> op) override;
 };
@@ -386,7 +412,7 @@ class AstTypeDecl : public Ast
 	const lexer::Token name;
 	const Type * const type;
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 };
 
 //------------------------------------------------------------------------------
@@ -409,7 +435,7 @@ class AstEnumDecl : public Ast
 	void add(lexer::Token name, ExprPtr &&expr);
 	void complete();
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 	void codegen() override;
 };
 
@@ -427,20 +453,21 @@ class AstStructDecl : public Ast
 	using MemberDecl = std::pair<std::vector<lexer::Token>, AstOrType>;
 	std::vector<MemberDecl> memberDecl;
 	std::vector<std::size_t> memberIndex;
+	std::vector<std::size_t> memberBitWidth;
 
     public:
 	AstStructDecl(lexer::Token structTypeName);
 
 	void add(std::vector<lexer::Token> &&memberName,
 		 std::vector<std::size_t> &&memberIndex,
-		 const Type *memberType);
+		 const Type *memberType, std::size_t bitWidth = 0);
 	void add(std::vector<lexer::Token> &&memberName,
 		 std::vector<std::size_t> &&memberIndex,
 		 AstPtr &&memberType);
 	void complete();
 	const Type *getStructType() const;
 
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 	void codegen() override;
 };
 
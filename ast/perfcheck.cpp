@@ -0,0 +1,216 @@
+#include <sstream>
+#include <string>
+
+#include "expr/binaryexpr.hpp"
+#include "expr/callexpr.hpp"
+#include "expr/compoundexpr.hpp"
+#include "expr/implicitcast.hpp"
+#include "gen/gentype.hpp"
+#include "lexer/error.hpp"
+
+#include "perfcheck.hpp"
+
+namespace abc {
+
+static std::size_t threshold;
+
+// size of 'type' if it is an aggregate, otherwise 0
+static std::size_t
+aggregateSize(const Type *type)
+{
+    type = type->getUnalias();
+    if ((!type->isArray() && !type->isStruct()) || !type->hasSize()) {
+	return 0;
+    }
+    return gen::getSizeof(type);
+}
+
+static bool
+isLarge(const Type *type)
+{
+    auto size = aggregateSize(type);
+    return size && size >= threshold;
+}
+
+static void
+warning(lexer::Loc loc, const std::string &msg, const std::string &note)
+{
+    error::location(loc);
+    error::out() << error::setColor(error::BOLD) << loc << ": "
+                 << error::setColor(error::BOLD_BLUE) << "warning: "
+                 << error::setColor(error::BOLD) << msg
+                 << " [-Wperformance]\n"
+                 << error::setColor(error::NORMAL);
+    error::out() << error::setColor(error::BOLD) << loc << ": "
+                 << error::setColor(error::BOLD_BLUE) << "note: "
+                 << error::setColor(error::BOLD) << note << "\n"
+                 << error::setColor(error::NORMAL);
+}
+
+//------------------------------------------------------------------------------
+
+static void
+checkFunction(const AstFuncDef *fn)
+{
+    const auto &paramType = fn->fnType->paramType();
+    const auto &paramName = fn->getParamName();
+    for (std::size_t i = 0; i < paramType.size(); ++i) {
+	if (fn->fnType->paramIn()[i] || !isLarge(paramType[i])) {
+	    continue;
+	}
+	std::ostringstream msg, note;
+	msg << "parameter '" << paramName[i].val << "' of type '"
+	    << paramType[i] << "' is passed by value ("
+	    << aggregateSize(paramType[i]) << " bytes per call)";
+	note << "pass it by reference instead, e.g. '" << paramName[i].val
+	     << ": in " << paramType[i] << "'";
+	warning(paramName[i].loc, msg.str(), note.str());
+    }
+
+    auto retType = fn->fnType->retType();
+    if (isLarge(retType)) {
+	std::ostringstream msg, note;
+	msg << "function '" << fn->fnName.val << "' returns '" << retType
+	    << "' by value (" << aggregateSize(retType) << " bytes per call)";
+	note << "let the caller pass a pointer to the result, e.g. "
+	     << "'result: -> " << retType << "'";
+	warning(fn->fnName.loc, msg.str(), note.str());
+    }
+}
+
+// expressions evaluated in each iteration of a loop
+static void
+checkLoopExpr(const Expr *expr)
+{
+    if (!expr) {
+	return;
+    }
+    expr->apply([](const Expr *e) -> bool {
+	if (auto assign = dynamic_cast<const BinaryExpr *>(e)) {
+	    if (assign->kind == BinaryExpr::ASSIGN && isLarge(assign->type)) {
+		std::ostringstream msg;
+		msg << "assignment copies " << aggregateSize(assign->type)
+		    << " bytes in each iteration";
+		warning(assign->loc, msg.str(),
+		        "access the source through a pointer or move the "
+		        "copy out of the loop");
+	    }
+	} else if (auto call = dynamic_cast<const CallExpr *>(e)) {
+	    const auto &paramIn = call->fn->type->paramIn();
+	    for (std::size_t i = 0; i < call->arg.size(); ++i) {
+		const auto &arg = call->arg[i];
+		if ((i < paramIn.size() && paramIn[i]) || !isLarge(arg->type)) {
+		    continue;
+		}
+		std::ostringstream msg, note;
+		msg << "argument of type '" << arg->type << "' copies "
+		    << aggregateSize(arg->type) << " bytes in each iteration";
+		note << "declare the parameter as 'in' or pass a pointer, "
+		     << "e.g. '-> readonly " << arg->type << "'";
+		warning(arg->loc, msg.str(), note.str());
+	    }
+	    if (isLarge(call->type)) {
+		std::ostringstream msg;
+		msg << "call returns " << aggregateSize(call->type)
+		    << " bytes by value in each iteration";
+		warning(call->loc, msg.str(),
+		        "let the callee write the result through a pointer");
+	    }
+	} else if (auto compound = dynamic_cast<const CompoundExpr *>(e)) {
+	    if (isLarge(compound->type)) {
+		std::ostringstream msg;
+		msg << "compound literal creates a temporary of "
+		    << aggregateSize(compound->type)
+		    << " bytes in each iteration";
+		warning(compound->loc, msg.str(),
+		        "move it out of the loop into a readonly variable");
+		return false;
+	    }
+	}
+	return true;
+    });
+}
+
+static void
+checkLoopVar(const Ast *decl)
+{
+    auto localVar = dynamic_cast<const AstLocalVar *>(decl);
+    if (!localVar) {
+	return;
+    }
+    for (const auto &node : localVar->declList->node) {
+	auto var = dynamic_cast<const AstVar *>(node.get());
+	auto init = var ? var->getInitializerExpr() : nullptr;
+	if (!init) {
+	    continue;
+	}
+	checkLoopExpr(init);
+
+	// copy of an existing aggregate (calls and compound literals are
+	// reported by checkLoopExpr)
+	auto src = init;
+	if (auto cast = dynamic_cast<const ImplicitCast *>(src)) {
+	    src = cast->expr.get();
+	}
+	if (isLarge(init->type) && !dynamic_cast<const CallExpr *>(src) &&
+	    !dynamic_cast<const CompoundExpr *>(src)) {
+	    std::ostringstream msg;
+	    msg << "initialization copies " << aggregateSize(init->type)
+	        << " bytes in each iteration";
+	    warning(init->loc, msg.str(),
+	            "use a pointer to the source instead of a copy");
+	}
+    }
+}
+
+static bool
+isLoop(const Ast *ast)
+{
+    return dynamic_cast<const AstWhile *>(ast) ||
+           dynamic_cast<const AstDoWhile *>(ast) ||
+           dynamic_cast<const AstFor *>(ast);
+}
+
+static std::function<bool(Ast *)>
+createCheck(bool inLoop)
+{
+    return [=](Ast *ast) -> bool {
+	if (isLoop(ast) && !inLoop) {
+	    // everything below is executed repeatedly
+	    ast->apply(createCheck(true));
+	    return false;
+	}
+
+	if (auto fn = dynamic_cast<const AstFuncDef *>(ast)) {
+	    checkFunction(fn);
+	} else if (!inLoop) {
+	    return true;
+	} else if (auto stmt = dynamic_cast<const AstExpr *>(ast)) {
+	    checkLoopExpr(stmt->expr.get());
+	} else if (auto stmt = dynamic_cast<const AstReturn *>(ast)) {
+	    checkLoopExpr(stmt->expr.get());
+	} else if (auto stmt = dynamic_cast<const AstIf *>(ast)) {
+	    checkLoopExpr(stmt->cond.get());
+	} else if (auto stmt = dynamic_cast<const AstWhile *>(ast)) {
+	    checkLoopExpr(stmt->cond.get());
+	} else if (auto stmt = dynamic_cast<const AstDoWhile *>(ast)) {
+	    checkLoopExpr(stmt->cond.get());
+	} else if (auto stmt = dynamic_cast<const AstFor *>(ast)) {
+	    checkLoopExpr(stmt->cond.get());
+	    checkLoopExpr(stmt->update.get());
+	    checkLoopExpr(stmt->range.get());
+	} else {
+	    checkLoopVar(ast);
+	}
+	return true;
+    };
+}
+
+void
+checkPerformance(Ast *ast, std::size_t threshold_)
+{
+    threshold = threshold_;
+    ast->apply(createCheck(false));
+}
+
+} // namespace abc
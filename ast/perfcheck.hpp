@@ -0,0 +1,17 @@
+#ifndef AST_PERFCHECK_HPP
+#define AST_PERFCHECK_HPP
+
+#include <cstddef>
+
+#include "ast.hpp"
+
+namespace abc {
+
+// Warns about aggregates of at least 'threshold' bytes that are passed or
+// returned by value, copied inside loops, or created as compound temporaries
+// inside loops (-Wperformance).
+void checkPerformance(Ast *ast, std::size_t threshold);
+
+} // namespace abc
+
+#endif // AST_PERFCHECK_HPP
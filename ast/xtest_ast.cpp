@@ -107,7 +107,7 @@ main()
     topLevel->append(makeMainDef());
 
     std::cerr << "AST:\n\n";
-    topLevel->print();
+    topLevel->print(std::cerr);
     topLevel->codegen();
 
     std::cerr << "\n";
@@ -111,14 +111,23 @@ AssertExpr::condition(gen::Label trueLabel, gen::Label falseLabel) const
     gen::jumpInstruction(cond, trueLabel, falseLabel);
 }
 
+// for traversing the expression tree
+void
+AssertExpr::apply(std::function<bool(const Expr *)> op) const
+{
+    if (op(this)) {
+	expr->apply(op);
+    }
+}
+
 // for debugging and educational purposes
 void
-AssertExpr::print(int indent) const
+AssertExpr::print(std::ostream &out, int indent) const
 {
     if (indent) {
-	std::cerr << std::setfill(' ') << std::setw(indent) << ' ';
+	out << std::setfill(' ') << std::setw(indent) << ' ';
     }
-    std::cerr << "assert (" << expr << ") [ " << type << " ] " << std::endl;
+    out << "assert (" << expr << ") [ " << type << " ] \n";
 }
 
 void
@@ -60,13 +60,22 @@ BinaryExpr::hasConstantAddress() const
 bool
 BinaryExpr::hasAddress() const
 {
-    return kind == INDEX;
+    // an element of a soa array only has member addresses, see Member, and an
+    // element of a packed bool array is only a bit
+    return kind == INDEX && !left->type->isSoaArray() &&
+           !left->type->isPackedBoolArray();
+}
+
+bool
+BinaryExpr::isPackedBoolElement() const
+{
+    return kind == INDEX && left->type->isPackedBoolArray();
 }
 
 bool
 BinaryExpr::isLValue() const
 {
-    return kind == INDEX;
+    return kind == INDEX && !left->type->isSoaArray();
 }
 
 bool
@@ -148,6 +157,12 @@ BinaryExpr::loadConstant() const
 	}
     case MUL:
     case DIV:
+	if (type->isFixedPoint()) {
+	    return gen::fixedPointInstruction(getGenInstructionOp(kind, type),
+	                                      left->loadConstant(),
+	                                      right->loadConstant(), type);
+	}
+	// fall through
     case MOD:
     case BITWISE_AND:
     case BITWISE_OR:
@@ -199,7 +214,7 @@ BinaryExpr::loadConstant() const
 }
 
 gen::Value
-BinaryExpr::handleArithmetricOperation(Kind kind) const
+BinaryExpr::handleArithmetricOperation(Kind kind, gen::Value leftVal) const
 {
     assert(type);
     switch (kind) {
@@ -211,36 +226,52 @@ BinaryExpr::handleArithmetricOperation(Kind kind) const
 	    // pointer + integer
 	    assert(left->type->isPointer());
 	    assert(right->type->isInteger());
-	    return gen::pointerIncrement(left->type->refType(),
-	                                 left->loadValue(), right->loadValue());
+	    return gen::pointerIncrement(left->type->refType(), leftVal,
+	                                 right->loadValue());
 	} else {
-	    return gen::instruction(getGenInstructionOp(kind, type),
-	                            left->loadValue(), right->loadValue());
+	    return gen::instruction(getGenInstructionOp(kind, type), leftVal,
+	                            right->loadValue());
 	}
     case SUB:
 	if (kind == SUB && left->type->isPointer()) {
 	    // pointer - pointer
 	    assert(right->type->isPointer());
 	    assert(type->isInteger());
-	    return gen::pointerDifference(
-	        left->type->refType(), left->loadValue(), right->loadValue());
+	    return gen::pointerDifference(left->type->refType(), leftVal,
+	                                  right->loadValue());
 	} else {
-	    return gen::instruction(getGenInstructionOp(kind, type),
-	                            left->loadValue(), right->loadValue());
+	    return gen::instruction(getGenInstructionOp(kind, type), leftVal,
+	                            right->loadValue());
 	}
     case MUL:
     case DIV:
+	if (type->isFixedPoint()) {
+	    return gen::fixedPointInstruction(getGenInstructionOp(kind, type),
+	                                      leftVal, right->loadValue(),
+	                                      type);
+	}
+	// fall through
     case MOD:
     case BITWISE_AND:
     case BITWISE_OR:
     case BITWISE_XOR:
     case BITWISE_LEFT_SHIFT:
     case BITWISE_RIGHT_SHIFT:
-	return gen::instruction(getGenInstructionOp(kind, type),
-	                        left->loadValue(), right->loadValue());
+	return gen::instruction(getGenInstructionOp(kind, type), leftVal,
+	                        right->loadValue());
     }
 }
 
+// 'left op= right': the address of 'left' is computed once and used for
+// both the load and the store
+gen::Value
+BinaryExpr::handleCompoundAssignment(Kind kind) const
+{
+    auto addr = left->loadAddress();
+    auto val = handleArithmetricOperation(kind, left->fetch(addr));
+    return left->store(val, addr);
+}
+
 gen::Value
 BinaryExpr::loadValue() const
 {
@@ -250,32 +281,27 @@ BinaryExpr::loadValue() const
     assert(type);
     switch (kind) {
     case ASSIGN:
-	return gen::store(right->loadValue(), left->loadAddress());
+	return left->store(right->loadValue(), left->loadAddress());
     case ADD_ASSIGN:
-	return gen::store(handleArithmetricOperation(ADD), left->loadAddress());
+	return handleCompoundAssignment(ADD);
     case SUB_ASSIGN:
-	return gen::store(handleArithmetricOperation(SUB), left->loadAddress());
+	return handleCompoundAssignment(SUB);
     case MUL_ASSIGN:
-	return gen::store(handleArithmetricOperation(MUL), left->loadAddress());
+	return handleCompoundAssignment(MUL);
     case DIV_ASSIGN:
-	return gen::store(handleArithmetricOperation(DIV), left->loadAddress());
+	return handleCompoundAssignment(DIV);
     case MOD_ASSIGN:
-	return gen::store(handleArithmetricOperation(MOD), left->loadAddress());
+	return handleCompoundAssignment(MOD);
     case BITWISE_AND_ASSIGN:
-	return gen::store(handleArithmetricOperation(BITWISE_AND),
-	                  left->loadAddress());
+	return handleCompoundAssignment(BITWISE_AND);
     case BITWISE_OR_ASSIGN:
-	return gen::store(handleArithmetricOperation(BITWISE_OR),
-	                  left->loadAddress());
+	return handleCompoundAssignment(BITWISE_OR);
     case BITWISE_XOR_ASSIGN:
-	return gen::store(handleArithmetricOperation(BITWISE_XOR),
-	                  left->loadAddress());
+	return handleCompoundAssignment(BITWISE_XOR);
     case BITWISE_LEFT_SHIFT_ASSIGN:
-	return gen::store(handleArithmetricOperation(BITWISE_LEFT_SHIFT),
-	                  left->loadAddress());
+	return handleCompoundAssignment(BITWISE_LEFT_SHIFT);
     case BITWISE_RIGHT_SHIFT_ASSIGN:
-	return gen::store(handleArithmetricOperation(BITWISE_RIGHT_SHIFT),
-	                  left->loadAddress());
+	return handleCompoundAssignment(BITWISE_RIGHT_SHIFT);
     case ADD:
     case SUB:
     case MUL:
@@ -286,7 +312,7 @@ BinaryExpr::loadValue() const
     case BITWISE_XOR:
     case BITWISE_LEFT_SHIFT:
     case BITWISE_RIGHT_SHIFT:
-	return handleArithmetricOperation(kind);
+	return handleArithmetricOperation(kind, left->loadValue());
     case LESS:
     case LESS_EQUAL:
     case GREATER:
@@ -314,7 +340,11 @@ BinaryExpr::loadValue() const
 	                IntegerType::createBool());
     }
     case INDEX:
-	return gen::fetch(loadAddress(), left->type->refType());
+	if (left->type->isSoaArray()) {
+	    return gen::soaFetch(left->type, left->loadAddress(),
+	                         right->loadValue());
+	}
+	return fetch(loadAddress());
 
     default:
 	error::out() << "kind = " << int(kind) << std::endl;
@@ -342,8 +372,12 @@ BinaryExpr::loadConstantAddress() const
 gen::Value
 BinaryExpr::loadAddress() const
 {
-    assert(hasAddress());
     assert(kind == INDEX);
+    if (isPackedBoolElement()) {
+	// the bit is selected by fetch() and store()
+	return left->loadAddress();
+    }
+    assert(hasAddress());
     if (left->type->isArray()) {
 	return gen::pointerIncrement(left->type->refType(), left->loadAddress(),
 	                             right->loadValue());
@@ -353,6 +387,24 @@ BinaryExpr::loadAddress() const
     }
 }
 
+gen::Value
+BinaryExpr::fetch(gen::Value addr) const
+{
+    if (isPackedBoolElement()) {
+	return gen::packedBoolFetch(left->type, addr, right->loadValue());
+    }
+    return Expr::fetch(addr);
+}
+
+gen::Value
+BinaryExpr::store(gen::Value val, gen::Value addr) const
+{
+    if (isPackedBoolElement()) {
+	return gen::packedBoolStore(val, left->type, addr, right->loadValue());
+    }
+    return Expr::store(val, addr);
+}
+
 void
 BinaryExpr::condition(gen::Label trueLabel, gen::Label falseLabel) const
 {
@@ -389,17 +441,27 @@ BinaryExpr::condition(gen::Label trueLabel, gen::Label falseLabel) const
     }
 }
 
+// for traversing the expression tree
+void
+BinaryExpr::apply(std::function<bool(const Expr *)> op) const
+{
+    if (op(this)) {
+	left->apply(op);
+	right->apply(op);
+    }
+}
+
 // for debugging and educational purposes
 
 void
-BinaryExpr::print(int indent) const
+BinaryExpr::print(std::ostream &out, int indent) const
 {
     if (indent) {
-	std::cerr << std::setfill(' ') << std::setw(indent) << ' ';
+	out << std::setfill(' ') << std::setw(indent) << ' ';
     }
-    std::cerr << kindStr(kind) << " [ " << type << " ] " << std::endl;
-    left->print(indent + 4);
-    right->print(indent + 4);
+    out << kindStr(kind) << " [ " << type << " ] \n";
+    left->print(out, indent + 4);
+    right->print(out, indent + 4);
 }
 
 void
@@ -515,6 +577,8 @@ static gen::InstructionOp
 getGenInstructionOp(abc::BinaryExpr::Kind kind, const abc::Type *type)
 {
     assert(type);
+    // fixed-point values are compared and divided like integers
+    auto isSigned = type->isSignedInteger() || type->isSignedFixedPoint();
     switch (kind) {
     case abc::BinaryExpr::Kind::ADD:
 	return type->isFloatType() ? gen::FADD : gen::ADD;
@@ -526,10 +590,10 @@ getGenInstructionOp(abc::BinaryExpr::Kind kind, const abc::Type *type)
 	if (type->isFloatType()) {
 	    return gen::FDIV;
 	} else {
-	    return type->isSignedInteger() ? gen::SDIV : gen::UDIV;
+	    return isSigned ? gen::SDIV : gen::UDIV;
 	}
     case abc::BinaryExpr::Kind::MOD:
-	return type->isSignedInteger() ? gen::SMOD : gen::UMOD;
+	return isSigned ? gen::SMOD : gen::UMOD;
     case abc::BinaryExpr::Kind::BITWISE_AND:
 	return gen::AND;
     case abc::BinaryExpr::Kind::BITWISE_OR:
@@ -539,7 +603,7 @@ getGenInstructionOp(abc::BinaryExpr::Kind kind, const abc::Type *type)
     case abc::BinaryExpr::Kind::BITWISE_LEFT_SHIFT:
 	return gen::SHL;
     case abc::BinaryExpr::Kind::BITWISE_RIGHT_SHIFT:
-	return type->isSignedInteger() ? gen::ASHR : gen::LSHR;
+	return isSigned ? gen::ASHR : gen::LSHR;
     case abc::BinaryExpr::Kind::EQUAL:
 	return type->isFloatType() ? gen::FEQ : gen::EQ;
     case abc::BinaryExpr::Kind::NOT_EQUAL:
@@ -548,25 +612,25 @@ getGenInstructionOp(abc::BinaryExpr::Kind kind, const abc::Type *type)
 	if (type->isFloatType()) {
 	    return gen::FLT;
 	} else {
-	    return type->isSignedInteger() ? gen::SLT : gen::ULT;
+	    return isSigned ? gen::SLT : gen::ULT;
 	}
     case abc::BinaryExpr::Kind::LESS_EQUAL:
 	if (type->isFloatType()) {
 	    return gen::FLE;
 	} else {
-	    return type->isSignedInteger() ? gen::SLE : gen::ULE;
+	    return isSigned ? gen::SLE : gen::ULE;
 	}
     case abc::BinaryExpr::Kind::GREATER:
 	if (type->isFloatType()) {
 	    return gen::FGT;
 	} else {
-	    return type->isSignedInteger() ? gen::SGT : gen::UGT;
+	    return isSigned ? gen::SGT : gen::UGT;
 	}
     case abc::BinaryExpr::Kind::GREATER_EQUAL:
 	if (type->isFloatType()) {
 	    return gen::FGE;
 	} else {
-	    return type->isSignedInteger() ? gen::SGE : gen::UGE;
+	    return isSigned ? gen::SGE : gen::UGE;
 	}
     case abc::BinaryExpr::Kind::LOGICAL_AND:
 	return gen::AND;
@@ -71,21 +71,31 @@ class BinaryExpr : public Expr
 
 	bool isConst() const override;
 
+	// element a[i] of a packed bool array
+	bool isPackedBoolElement() const;
+
 	// for code generation
 	gen::Constant loadConstant() const override;
 
     private:
-	gen::Value handleArithmetricOperation(Kind kind) const;
+	gen::Value handleArithmetricOperation(Kind kind,
+	                                      gen::Value leftVal) const;
+	gen::Value handleCompoundAssignment(Kind kind) const;
 
     public:
 	gen::Value loadValue() const override;
 	gen::Constant loadConstantAddress() const override;
 	gen::Value loadAddress() const override;
+	gen::Value fetch(gen::Value addr) const override;
+	gen::Value store(gen::Value val, gen::Value addr) const override;
 	void condition(gen::Label trueLabel,
 	               gen::Label falseLabel) const override;
 
+	// for traversing the expression tree
+	void apply(std::function<bool(const Expr *)> op) const override;
+
 	// for debugging and educational purposes
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 
 	// for printing error messages
 	virtual void printFlat(std::ostream &out, int prec) const override;
@@ -0,0 +1,119 @@
+#include <iomanip>
+#include <iostream>
+
+#include "gen/instruction.hpp"
+#include "gen/variable.hpp"
+#include "lexer/error.hpp"
+#include "type/integertype.hpp"
+
+#include "bitcount.hpp"
+
+namespace abc {
+
+BitCount::BitCount(ExprPtr &&expr, lexer::Loc loc)
+    : Expr{loc, IntegerType::createSizeType()}, expr{std::move(expr)}
+{
+}
+
+ExprPtr
+BitCount::create(ExprPtr &&expr, lexer::Loc loc)
+{
+    assert(expr);
+    assert(expr->type);
+    if (expr->type->isPackedBoolArray()) {
+	if (!expr->hasAddress()) {
+	    error::location(expr->loc);
+	    error::out() << error::setColor(error::BOLD) << expr->loc << ": "
+	                 << error::setColor(error::BOLD_RED)
+	                 << "error: " << error::setColor(error::BOLD)
+	                 << "packed array has no address\n"
+	                 << error::setColor(error::NORMAL);
+	    error::fatal();
+	    return nullptr;
+	}
+    } else if (!expr->type->isInteger() || expr->type->isBool()) {
+	error::location(expr->loc);
+	error::out() << error::setColor(error::BOLD) << expr->loc << ": "
+	             << error::setColor(error::BOLD_RED)
+	             << "error: " << error::setColor(error::BOLD)
+	             << "bitcount requires an integer or a packed array, "
+	             << "not '" << expr->type << "'\n"
+	             << error::setColor(error::NORMAL);
+	error::fatal();
+	return nullptr;
+    }
+    auto p = new BitCount{std::move(expr), loc};
+    return std::unique_ptr<BitCount>{p};
+}
+
+bool
+BitCount::hasAddress() const
+{
+    return false;
+}
+
+bool
+BitCount::isLValue() const
+{
+    return false;
+}
+
+bool
+BitCount::isConst() const
+{
+    return false;
+}
+
+// for code generation
+gen::Constant
+BitCount::loadConstant() const
+{
+    assert(0 && "BitCount is not a constant");
+    return nullptr;
+}
+
+gen::Value
+BitCount::loadValue() const
+{
+    if (expr->type->isPackedBoolArray()) {
+	return gen::packedBoolCount(expr->type, expr->loadAddress());
+    }
+    return gen::bitCount(expr->loadValue());
+}
+
+gen::Value
+BitCount::loadAddress() const
+{
+    assert(0 && "BitCount has no address");
+    return nullptr;
+}
+
+// for traversing the expression tree
+void
+BitCount::apply(std::function<bool(const Expr *)> op) const
+{
+    if (op(this)) {
+	expr->apply(op);
+    }
+}
+
+// for debugging and educational purposes
+void
+BitCount::print(std::ostream &out, int indent) const
+{
+    if (indent) {
+	out << std::setfill(' ') << std::setw(indent) << ' ';
+    }
+    out << "bitcount [ " << type << " ] \n";
+    expr->print(out, indent + 4);
+}
+
+void
+BitCount::printFlat(std::ostream &out, int prec) const
+{
+    out << "bitcount(";
+    expr->printFlat(out, 0);
+    out << ")";
+}
+
+} // namespace abc
@@ -0,0 +1,43 @@
+#ifndef EXPR_BITCOUNT_HPP
+#define EXPR_BITCOUNT_HPP
+
+#include "expr.hpp"
+#include "lexer/loc.hpp"
+
+namespace abc {
+
+// 'bitcount(expr)': number of set bits of an integer or of the elements of a
+// 'packed array[N] of bool' that are true
+class BitCount : public Expr
+{
+    protected:
+	BitCount(ExprPtr &&expr, lexer::Loc loc);
+
+    public:
+	static ExprPtr create(ExprPtr &&expr, lexer::Loc loc = lexer::Loc{});
+
+	const ExprPtr expr;
+
+	// for sematic checks
+	bool hasAddress() const override;
+	bool isLValue() const override;
+	bool isConst() const override;
+
+	// for code generation
+	gen::Constant loadConstant() const override;
+	gen::Value loadValue() const override;
+	gen::Value loadAddress() const override;
+
+	// for traversing the expression tree
+	void apply(std::function<bool(const Expr *)> op) const override;
+
+	// for debugging and educational purposes
+	void print(std::ostream &out, int indent) const override;
+
+	// for printing error messages
+	void printFlat(std::ostream &out, int prec) const override;
+};
+
+} // namespace abc
+
+#endif // EXPR_BITCOUNT_HPP
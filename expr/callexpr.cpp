@@ -1,14 +1,22 @@
 #include <iomanip>
 #include <iostream>
 
+#include "gen/constant.hpp"
 #include "gen/function.hpp"
 #include "gen/variable.hpp"
+#include "type/functiontype.hpp"
+#include "type/integertype.hpp"
 
 #include "callexpr.hpp"
+#include "identifier.hpp"
 #include "promotion.hpp"
 
 namespace abc {
 
+static bool heapProfile;
+static UStr heapMallocName, heapFreeName;
+static const Type *heapMallocType, *heapFreeType;
+
 CallExpr::CallExpr(ExprPtr &&fn, std::vector<ExprPtr> &&arg, const Type *type,
                    lexer::Loc loc)
     : Expr{loc, type}, fn{std::move(fn)}, arg{std::move(arg)}
@@ -34,9 +42,58 @@ CallExpr::create(ExprPtr &&fn, std::vector<ExprPtr> &&arg, lexer::Loc loc)
     auto p = new CallExpr{std::move(std::get<0>(promotion)),
                           std::move(std::get<1>(promotion)),
                           std::get<2>(promotion), loc};
+    if (heapProfile) {
+	p->redirectHeapCall();
+    }
     return std::unique_ptr<CallExpr>{p};
 }
 
+void
+CallExpr::enableHeapProfile(bool enable)
+{
+    heapProfile = enable;
+}
+
+bool
+CallExpr::heapProfileEnabled()
+{
+    return heapProfile;
+}
+
+void
+CallExpr::setHeapProfileFunctions(UStr mallocName, const Type *mallocType,
+                                  UStr freeName, const Type *freeType)
+{
+    heapMallocName = mallocName;
+    heapMallocType = mallocType;
+    heapFreeName = freeName;
+    heapFreeType = freeType;
+}
+
+// Only calls of malloc and free declared as in stdlib.hdr are redirected. The
+// wrapper has the same parameter followed by the file and line of the call.
+void
+CallExpr::redirectHeapCall()
+{
+    auto ident = dynamic_cast<const Identifier *>(fn.get());
+    if (!ident || !heapMallocType || !heapFreeType) {
+	return;
+    }
+    auto matches = [&](const char *name, const Type *wrapperType) {
+	std::vector<const Type *> param{wrapperType->paramType()[0]};
+	auto fnType = FunctionType::create(wrapperType->retType(),
+	                                   std::move(param));
+	return ident->id == UStr::create(name) && Type::equals(fn->type, fnType);
+    };
+    if (matches("malloc", heapMallocType)) {
+	heapFnName = heapMallocName;
+	heapFnType = heapMallocType;
+    } else if (matches("free", heapFreeType)) {
+	heapFnName = heapFreeName;
+	heapFnType = heapFreeType;
+    }
+}
+
 bool
 CallExpr::hasAddress() const
 {
@@ -66,15 +123,43 @@ CallExpr::loadConstant() const
 gen::Value
 CallExpr::loadValue() const
 {
+    const auto &paramIn = fn->type->paramIn();
     std::vector<gen::Value> argValue;
-    for (const auto &a : arg) {
-	argValue.push_back(a->loadValue());
+    for (std::size_t i = 0; i < arg.size(); ++i) {
+	if (i < paramIn.size() && paramIn[i]) {
+	    argValue.push_back(loadArgAddress(i));
+	} else {
+	    argValue.push_back(arg[i]->loadValue());
+	}
+    }
+    if (heapFnType) {
+	argValue.push_back(gen::loadStringAddress(loc.path.c_str()));
+	argValue.push_back(
+	    gen::getConstantInt(loc.from.line, IntegerType::createInt()));
+	auto fnAddr = gen::loadAddress(heapFnName.c_str());
+	return gen::functionCall(fnAddr, heapFnType, argValue);
     }
     auto fnAddr = fn->loadAddress();
     auto call = gen::functionCall(fnAddr, fn->type, argValue);
     return call;
 }
 
+// 'in' arguments are passed by reference. Values without an address are
+// stored in a temporary first.
+gen::Value
+CallExpr::loadArgAddress(std::size_t i) const
+{
+    if (arg[i]->hasAddress()) {
+	return arg[i]->loadAddress();
+    }
+    std::stringstream ss;
+    ss << tmpId.c_str() << ".arg" << i;
+    auto argTmpId = UStr::create(ss.str()).c_str();
+    auto tmpAddr = gen::localVariableDefinition(argTmpId, arg[i]->type);
+    gen::store(arg[i]->loadValue(), tmpAddr);
+    return tmpAddr;
+}
+
 gen::Value
 CallExpr::loadAddress() const
 {
@@ -82,17 +167,29 @@ CallExpr::loadAddress() const
     return gen::loadAddress(tmpId.c_str());
 }
 
+// for traversing the expression tree
+void
+CallExpr::apply(std::function<bool(const Expr *)> op) const
+{
+    if (op(this)) {
+	fn->apply(op);
+	for (const auto &e : arg) {
+	    e->apply(op);
+	}
+    }
+}
+
 // for debugging and educational purposes
 void
-CallExpr::print(int indent) const
+CallExpr::print(std::ostream &out, int indent) const
 {
     if (indent) {
-	std::cerr << std::setfill(' ') << std::setw(indent) << ' ';
+	out << std::setfill(' ') << std::setw(indent) << ' ';
     }
-    std::cerr << "call [ " << type << " ] " << std::endl;
-    fn->print(indent + 4);
+    out << "call [ " << type << " ] \n";
+    fn->print(out, indent + 4);
     for (const auto &a : arg) {
-	a->print(indent + 4);
+	a->print(out, indent + 4);
     }
 }
 
@@ -12,13 +12,26 @@ class CallExpr : public Expr
 	         lexer::Loc loc);
 
 	UStr tmpId;
+	// wrapper that gets called instead of 'fn' (-fheap-profile)
+	UStr heapFnName;
+	const Type *heapFnType = nullptr;
 
 	void initTmp() const;
+	gen::Value loadArgAddress(std::size_t i) const;
+	void redirectHeapCall();
 
     public:
 	static ExprPtr create(ExprPtr &&fn, std::vector<ExprPtr> &&arg,
 	                      lexer::Loc loc = lexer::Loc{});
 
+	// -fheap-profile: calls of malloc and free are redirected to wrappers
+	// that also receive the source location of the call
+	static void enableHeapProfile(bool enable);
+	static bool heapProfileEnabled();
+	static void setHeapProfileFunctions(UStr mallocName,
+	                                    const Type *mallocType,
+	                                    UStr freeName, const Type *freeType);
+
 	ExprPtr fn;
 	std::vector<ExprPtr> arg;
 
@@ -31,8 +44,11 @@ class CallExpr : public Expr
 	gen::Value loadValue() const override;
 	gen::Value loadAddress() const override;
 
+	// for traversing the expression tree
+	void apply(std::function<bool(const Expr *)> op) const override;
+
 	// for debugging and educational purposes
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 
 	// for printing error messages
 	virtual void printFlat(std::ostream &out, int prec) const override;
@@ -68,12 +68,12 @@ CharacterLiteral::loadAddress() const
 
 // for debugging and educational purposes
 void
-CharacterLiteral::print(int indent) const
+CharacterLiteral::print(std::ostream &out, int indent) const
 {
     if (indent) {
-	std::cerr << std::setfill(' ') << std::setw(indent) << ' ';
+	out << std::setfill(' ') << std::setw(indent) << ' ';
     }
-    std::cerr << val << " [ " << type << " ] " << std::endl;
+    out << val << " [ " << type << " ] \n";
 }
 
 void
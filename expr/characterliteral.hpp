@@ -29,7 +29,7 @@ class CharacterLiteral : public Expr
 	gen::Value loadAddress() const override;
 
 	// for debugging and educational purposes
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 
 	// for printing error messages
 	void printFlat(std::ostream &out, int prec) const override;
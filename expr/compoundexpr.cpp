@@ -192,12 +192,25 @@ CompoundExpr::loadValue(std::size_t index) const
     }
 }
 
+// for traversing the expression tree
+void
+CompoundExpr::apply(std::function<bool(const Expr *)> op) const
+{
+    if (op(this)) {
+	for (const auto &e : expr) {
+	    if (e) {
+		e->apply(op);
+	    }
+	}
+    }
+}
+
 // for debugging and educational purposes
 void
-CompoundExpr::print(int indent) const
+CompoundExpr::print(std::ostream &out, int indent) const
 {
-    std::cerr << std::setfill(' ') << std::setw(indent) << ' ';
-    printFlat(std::cerr, 0);
+    out << std::setfill(' ') << std::setw(indent) << ' ';
+    printFlat(out, 0);
 }
 
 // for printing error messages
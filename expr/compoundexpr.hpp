@@ -56,8 +56,11 @@ class CompoundExpr : public Expr
 	gen::Constant loadConstant(std::size_t index) const;
 	gen::Value loadValue(std::size_t index) const;
 
+	// for traversing the expression tree
+	void apply(std::function<bool(const Expr *)> op) const override;
+
 	// for debugging and educational purposes
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 
 	// for printing error messages
 	virtual void printFlat(std::ostream &out, int prec) const override;
@@ -145,16 +145,27 @@ ConditionalExpr::condition(gen::Label trueLabel, gen::Label falseLabel) const
     gen::jumpInstruction(cond, trueLabel, falseLabel);
 }
 
+// for traversing the expression tree
+void
+ConditionalExpr::apply(std::function<bool(const Expr *)> op) const
+{
+    if (op(this)) {
+	cond->apply(op);
+	trueExpr->apply(op);
+	falseExpr->apply(op);
+    }
+}
+
 // for debugging and educational purposes
 void
-ConditionalExpr::print(int indent) const
+ConditionalExpr::print(std::ostream &out, int indent) const
 {
     if (indent) {
-	std::cerr << std::setfill(' ') << std::setw(indent) << ' ';
+	out << std::setfill(' ') << std::setw(indent) << ' ';
     }
-    std::cerr << "? .. : ..." << " [ " << type << " ] " << std::endl;
-    trueExpr->print(indent + 4);
-    falseExpr->print(indent + 4);
+    out << "? .. : ..." << " [ " << type << " ] \n";
+    trueExpr->print(out, indent + 4);
+    falseExpr->print(out, indent + 4);
 }
 
 void
@@ -33,8 +33,11 @@ class ConditionalExpr : public Expr
 	void condition(gen::Label trueLabel,
 	               gen::Label falseLabel) const override;
 
+	// for traversing the expression tree
+	void apply(std::function<bool(const Expr *)> op) const override;
+
 	// for debugging and educational purposes
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 
 	// for printing error messages
 	virtual void printFlat(std::ostream &out, int prec) const override;
@@ -64,12 +64,12 @@ EnumConstant::loadAddress() const
 
 // for debugging and educational purposes
 void
-EnumConstant::print(int indent) const
+EnumConstant::print(std::ostream &out, int indent) const
 {
     if (indent) {
-	std::cerr << std::setfill(' ') << std::setw(indent) << ' ';
+	out << std::setfill(' ') << std::setw(indent) << ' ';
     }
-    std::cerr << name << " [ " << value << " ] " << std::endl;
+    out << name << " [ " << value << " ] \n";
 }
 
 void
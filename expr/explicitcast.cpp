@@ -137,13 +137,22 @@ ExplicitCast::loadAddress() const
     return nullptr;
 }
 
+// for traversing the expression tree
+void
+ExplicitCast::apply(std::function<bool(const Expr *)> op) const
+{
+    if (op(this)) {
+	expr->apply(op);
+    }
+}
+
 // for debugging and educational purposes
 void
-ExplicitCast::print(int indent) const
+ExplicitCast::print(std::ostream &out, int indent) const
 {
-    std::cerr << std::setfill(' ') << std::setw(indent) << ' ';
-    std::cerr << "cast" << " [ " << type << " ] " << std::endl;
-    expr->print(indent + 4);
+    out << std::setfill(' ') << std::setw(indent) << ' ';
+    out << "cast" << " [ " << type << " ] \n";
+    expr->print(out, indent + 4);
 }
 
 // for printing error messages
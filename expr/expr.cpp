@@ -1,12 +1,17 @@
 #include "gen/constant.hpp"
 #include "gen/instruction.hpp"
+#include "gen/variable.hpp"
 #include "lexer/error.hpp"
+#include "util/stats.hpp"
 
 #include "expr.hpp"
 
 namespace abc {
 
-Expr::Expr(lexer::Loc loc, const Type *type) : loc{loc}, type{type} {}
+Expr::Expr(lexer::Loc loc, const Type *type) : loc{loc}, type{type}
+{
+    stats::count(stats::EXPR_NODES);
+}
 
 bool
 Expr::hasConstantAddress() const
@@ -21,6 +26,18 @@ Expr::loadConstantAddress() const
     return nullptr;
 }
 
+gen::Value
+Expr::fetch(gen::Value addr) const
+{
+    return gen::fetch(addr, type);
+}
+
+gen::Value
+Expr::store(gen::Value val, gen::Value addr) const
+{
+    return gen::store(val, addr);
+}
+
 void
 Expr::condition(gen::Label trueLabel, gen::Label falseLabel) const
 {
@@ -38,6 +55,12 @@ Expr::condition(gen::Label trueLabel, gen::Label falseLabel) const
     gen::jumpInstruction(cond, trueLabel, falseLabel);
 }
 
+void
+Expr::apply(std::function<bool(const Expr *)> op) const
+{
+    op(this);
+}
+
 gen::ConstantInt
 Expr::getConstantInt() const
 {
@@ -2,6 +2,7 @@
 #define EXPR_EXPR_HPP
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 
 #include "gen/gen.hpp"
@@ -32,11 +33,19 @@ class Expr
 	virtual gen::Value loadValue() const = 0;
 	virtual gen::Constant loadConstantAddress() const;
 	virtual gen::Value loadAddress() const = 0;
+	// for lvalues: load and store through 'addr' returned by loadAddress().
+	// Bit-fields and elements of packed arrays override them.
+	virtual gen::Value fetch(gen::Value addr) const;
+	virtual gen::Value store(gen::Value val, gen::Value addr) const;
 	virtual void condition(gen::Label trueLabel,
 	                       gen::Label falseLabel) const;
 
+	// for traversing the expression tree: 'op' is applied to this
+	// expression and, if it returns true, to all evaluated subexpressions
+	virtual void apply(std::function<bool(const Expr *)> op) const;
+
 	// for debugging and educational purposes
-	virtual void print(int indent = 1) const = 0;
+	virtual void print(std::ostream &out, int indent = 1) const = 0;
 
 	// for printing error messages
 	virtual void printFlat(std::ostream &out, int prec) const = 0;
@@ -68,12 +68,23 @@ ExprList::loadAddress() const
     return nullptr;
 }
 
+// for traversing the expression tree
+void
+ExprList::apply(std::function<bool(const Expr *)> op) const
+{
+    if (op(this)) {
+	for (const auto &e : exprVec) {
+	    e->apply(op);
+	}
+    }
+}
+
 // for debugging and educational purposes
 void
-ExprList::print(int indent) const
+ExprList::print(std::ostream &out, int indent) const
 {
-    std::cerr << std::setfill(' ') << std::setw(indent) << ' ';
-    printFlat(std::cerr, 0);
+    out << std::setfill(' ') << std::setw(indent) << ' ';
+    printFlat(out, 0);
 }
 
 // for printing error messages
@@ -71,12 +71,12 @@ FloatLiteral::loadAddress() const
 
 // for debugging and educational purposes
 void
-FloatLiteral::print(int indent) const
+FloatLiteral::print(std::ostream &out, int indent) const
 {
     if (indent) {
-	std::cerr << std::setfill(' ') << std::setw(indent) << ' ';
+	out << std::setfill(' ') << std::setw(indent) << ' ';
     }
-    std::cerr << val << " [ " << type << " ] " << std::endl;
+    out << val << " [ " << type << " ] \n";
 }
 
 void
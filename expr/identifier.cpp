@@ -7,23 +7,30 @@
 
 namespace abc {
 
-Identifier::Identifier(UStr name, UStr id, const Type *type, lexer::Loc loc)
-    : Expr{loc, type}, name{name}, id{id}
+Identifier::Identifier(UStr name, UStr id, const Type *type, lexer::Loc loc,
+                       const Expr *constExpr, bool externalLinkage,
+                       bool inParam)
+    : Expr{loc, type}, name{name}, id{id}, constExpr{constExpr},
+      externalLinkage{externalLinkage}, inParam{inParam}
 {
 }
 
 ExprPtr
-Identifier::create(UStr name, UStr id, const Type *type, lexer::Loc loc)
+Identifier::create(UStr name, UStr id, const Type *type, lexer::Loc loc,
+                   const Expr *constExpr, bool externalLinkage,
+                   bool inParam)
 {
     assert(type);
-    auto p = new Identifier{name, id, type, loc};
+    assert(!constExpr || constExpr->isConst());
+    auto p = new Identifier{name, id, type, loc, constExpr, externalLinkage,
+                            inParam};
     return std::unique_ptr<Identifier>{p};
 }
 
 bool
 Identifier::hasConstantAddress() const
 {
-    return gen::hasConstantAddress(id.c_str());
+    return constExpr || gen::hasConstantAddress(id.c_str());
 }
 
 bool
@@ -42,22 +49,24 @@ Identifier::isLValue() const
 bool
 Identifier::isConst() const
 {
-    return false;
+    return constExpr;
 }
 
 // for code generation
 gen::Constant
 Identifier::loadConstant() const
 {
-    assert(0);
-    return nullptr;
+    assert(isConst());
+    return constExpr->loadConstant();
 }
 
 gen::Value
 Identifier::loadValue() const
 {
     assert(type);
-    if (type->isFunction()) {
+    if (isConst()) {
+	return loadConstant();
+    } else if (type->isFunction()) {
 	return loadAddress();
     }
     return gen::fetch(loadAddress(), type);
@@ -68,6 +77,11 @@ Identifier::loadConstantAddress() const
 {
     assert(hasConstantAddress());
     assert(id.c_str());
+    if (constExpr) {
+	// the variable is only defined if its address is used
+	return gen::constantVariableDefinition(id.c_str(), type,
+	                                       loadConstant(), externalLinkage);
+    }
     return gen::loadConstantAddress(id.c_str());
 }
 
@@ -76,17 +90,20 @@ Identifier::loadAddress() const
 {
     assert(hasAddress());
     assert(id.c_str());
+    if (constExpr) {
+	return loadConstantAddress();
+    }
     return gen::loadAddress(id.c_str());
 }
 
 // for debugging and educational purposes
 void
-Identifier::print(int indent) const
+Identifier::print(std::ostream &out, int indent) const
 {
     if (indent) {
-	std::cerr << std::setfill(' ') << std::setw(indent) << ' ';
+	out << std::setfill(' ') << std::setw(indent) << ' ';
     }
-    std::cerr << name << " [ " << type << " ] " << std::endl;
+    out << name << " [ " << type << " ] \n";
 }
 
 void
@@ -11,14 +11,23 @@ namespace abc {
 class Identifier : public Expr
 {
     protected:
-	Identifier(UStr name, UStr id, const Type *type, lexer::Loc loc);
+	Identifier(UStr name, UStr id, const Type *type, lexer::Loc loc,
+	           const Expr *constExpr, bool externalLinkage, bool inParam);
 
     public:
 	static ExprPtr create(UStr name, UStr id, const Type *type,
-	                      lexer::Loc loc = lexer::Loc{});
+	                      lexer::Loc loc = lexer::Loc{},
+	                      const Expr *constExpr = nullptr,
+	                      bool externalLinkage = false,
+	                      bool inParam = false);
 
 	const UStr name;
 	const UStr id;
+	// for global constants, see symtab::Entry::getConstExpr()
+	const Expr *const constExpr;
+	const bool externalLinkage;
+	// for 'in' parameters, see symtab::Entry::isInParam()
+	const bool inParam;
 
 	virtual bool hasConstantAddress() const override;
 	bool hasAddress() const override;
@@ -32,7 +41,7 @@ class Identifier : public Expr
 	gen::Value loadAddress() const override;
 
 	// for debugging and educational purposes
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 
 	// for printing error messages
 	virtual void printFlat(std::ostream &out, int prec) const override;
@@ -153,13 +153,22 @@ ImplicitCast::loadAddress() const
     return tmpAddr;
 }
 
+// for traversing the expression tree
+void
+ImplicitCast::apply(std::function<bool(const Expr *)> op) const
+{
+    if (op(this)) {
+	expr->apply(op);
+    }
+}
+
 // for debugging and educational purposes
 void
-ImplicitCast::print(int indent) const
+ImplicitCast::print(std::ostream &out, int indent) const
 {
-    std::cerr << std::setfill(' ') << std::setw(indent) << ' ';
-    std::cerr << "cast" << " [ " << type << " ] " << std::endl;
-    expr->print(indent + 4);
+    out << std::setfill(' ') << std::setw(indent) << ' ';
+    out << "cast" << " [ " << type << " ] \n";
+    expr->print(out, indent + 4);
 }
 
 // for printing error messages
@@ -87,15 +87,15 @@ IntegerLiteral::loadAddress() const
 
 // for debugging and educational purposes
 void
-IntegerLiteral::print(int indent) const
+IntegerLiteral::print(std::ostream &out, int indent) const
 {
     if (indent) {
-	std::cerr << std::setfill(' ') << std::setw(indent) << ' ';
+	out << std::setfill(' ') << std::setw(indent) << ' ';
     }
     if (radix != 10) {
-	std::cerr << int(radix) << "'";
+	out << int(radix) << "'";
     }
-    std::cerr << val << " [ " << type << " ] " << std::endl;
+    out << val << " [ " << type << " ] \n";
 }
 
 void
@@ -132,9 +132,12 @@ getIntType(const char *s, const char *end, std::uint8_t radix,
            abc::lexer::Loc loc)
 {
     // TODO: Handle type of integer literals like in Rust. Currently handled
-    //	    like in C, i.e. it is at least of type 'int' (where i32 is choosen)
+    //	    like in C, i.e. it is at least of type 'int' (where i32 is choosen,
+    //	    or i16 on targets with a 16-bit int)
     const abc::Type *ty = nullptr;
-    if (getIntType<std::int32_t, 32>(s, end, radix, ty) ||
+    bool int16 = abc::IntegerType::createInt()->numBits() == 16;
+    if ((int16 && getIntType<std::int16_t, 16>(s, end, radix, ty)) ||
+        getIntType<std::int32_t, 32>(s, end, radix, ty) ||
         getIntType<std::int64_t, 64>(s, end, radix, ty)) {
 	return ty;
     }
@@ -0,0 +1,92 @@
+#include <cassert>
+#include <iomanip>
+#include <iostream>
+
+#include "gen/label.hpp"
+#include "lexer/error.hpp"
+#include "type/pointertype.hpp"
+#include "type/voidtype.hpp"
+
+#include "labeladdress.hpp"
+
+namespace abc {
+
+LabelAddress::LabelAddress(UStr labelName, lexer::Loc loc)
+    : Expr{loc, PointerType::create(VoidType::create())}, labelName{labelName}
+{
+}
+
+ExprPtr
+LabelAddress::create(UStr labelName, lexer::Loc loc)
+{
+    auto p = new LabelAddress{labelName, loc};
+    return std::unique_ptr<LabelAddress>{p};
+}
+
+bool
+LabelAddress::hasAddress() const
+{
+    return false;
+}
+
+bool
+LabelAddress::isLValue() const
+{
+    return false;
+}
+
+// a block address is a constant, e.g. in a 'static' table of labels
+bool
+LabelAddress::isConst() const
+{
+    return true;
+}
+
+// for code generation
+gen::Constant
+LabelAddress::loadConstant() const
+{
+    auto label = gen::findLabel(labelName.c_str());
+    if (!label) {
+	error::location(loc);
+	error::out() << error::setColor(error::BOLD) << loc << ": "
+	             << error::setColor(error::BOLD_RED)
+	             << "error: " << error::setColor(error::BOLD)
+	             << "no label '" << labelName << "' within function\n"
+	             << error::setColor(error::NORMAL);
+	error::fatal();
+	return nullptr;
+    }
+    return gen::labelAddress(label);
+}
+
+gen::Value
+LabelAddress::loadValue() const
+{
+    return loadConstant();
+}
+
+gen::Value
+LabelAddress::loadAddress() const
+{
+    assert(0 && "LabelAddress has no address");
+    return nullptr;
+}
+
+// for debugging and educational purposes
+void
+LabelAddress::print(std::ostream &out, int indent) const
+{
+    if (indent) {
+	out << std::setfill(' ') << std::setw(indent) << ' ';
+    }
+    out << "&&" << labelName << " [ " << type << " ] \n";
+}
+
+void
+LabelAddress::printFlat(std::ostream &out, int prec) const
+{
+    out << "&&" << labelName;
+}
+
+} // namespace abc
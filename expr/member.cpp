@@ -4,14 +4,28 @@
 #include "gen/variable.hpp"
 #include "lexer/error.hpp"
 
+#include "binaryexpr.hpp"
 #include "member.hpp"
 
 namespace abc {
 
+// returns the index expression if 'structure' is an element a[i] of a soa
+// array
+static const BinaryExpr *
+soaElement(const Expr *structure)
+{
+    auto e = dynamic_cast<const BinaryExpr *>(structure);
+    if (e && e->kind == BinaryExpr::INDEX && e->left->type->isSoaArray()) {
+	return e;
+    }
+    return nullptr;
+}
+
 Member::Member(ExprPtr &&structure, UStr member, const Type *type,
-               std::size_t index, lexer::Loc loc)
+               std::size_t index, std::size_t bitOffset, std::size_t bitWidth,
+               lexer::Loc loc)
     : Expr{loc, type}, structure{std::move(structure)}, member{member},
-      index{index}
+      index{index}, bitOffset{bitOffset}, bitWidth{bitWidth}
 {
 }
 
@@ -35,7 +49,7 @@ Member::create(ExprPtr &&structure, bool derefStructPtr, UStr member,
     auto structureType =
         derefStructPtr ? structure->type->refType() : structure->type;
 
-    if (!structure->hasAddress()) {
+    if (!structure->hasAddress() && !soaElement(structure.get())) {
 	error::location(loc);
 	error::out() << error::setColor(error::BOLD) << structure->loc << ": "
 	             << error::setColor(error::BOLD_RED)
@@ -47,7 +61,7 @@ Member::create(ExprPtr &&structure, bool derefStructPtr, UStr member,
     }
 
     const Type *type = nullptr;
-    std::size_t index = 0;
+    std::size_t index = 0, bitOffset = 0, bitWidth = 0;
     if (structureType->isStruct() && structureType->hasSize()) {
 	const auto &memberName = structureType->memberName();
 	const auto &memberIndex = structureType->memberIndex();
@@ -56,6 +70,8 @@ Member::create(ExprPtr &&structure, bool derefStructPtr, UStr member,
 	    if (member == memberName[i]) {
 		type = memberType[i];
 		index = memberIndex[i];
+		bitOffset = structureType->memberBitOffset()[i];
+		bitWidth = structureType->memberBitWidth()[i];
 		break;
 	    }
 	}
@@ -99,7 +115,8 @@ Member::create(ExprPtr &&structure, bool derefStructPtr, UStr member,
 	error::fatal();
 	return nullptr;
     } else {
-	auto p = new Member{std::move(structure), member, type, index, loc};
+	auto p = new Member{std::move(structure), member, type, index,
+	                    bitOffset, bitWidth, loc};
 	return std::unique_ptr<Member>{p};
     }
 }
@@ -108,7 +125,8 @@ bool
 Member::hasAddress() const
 {
     assert(type);
-    return true;
+    // a bit-field only has the address of its storage unit
+    return bitWidth == 0;
 }
 
 bool
@@ -135,12 +153,16 @@ gen::Value
 Member::loadValue() const
 {
     assert(type);
-    return gen::fetch(loadAddress(), type);
+    return fetch(loadAddress());
 }
 
 gen::Value
 Member::loadAddress() const
 {
+    if (auto e = soaElement(structure.get())) {
+	return gen::soaMemberAddress(e->left->type, e->left->loadAddress(),
+	                             index, e->right->loadValue());
+    }
     auto structureType = structure->type->isPointer()
                              ? structure->type->refType()
                              : structure->type;
@@ -150,15 +172,42 @@ Member::loadAddress() const
     return gen::pointerToIndex(structureType, structureAddress, index);
 }
 
+gen::Value
+Member::fetch(gen::Value addr) const
+{
+    if (bitWidth) {
+	return gen::bitFieldFetch(addr, type, bitOffset, bitWidth);
+    }
+    return Expr::fetch(addr);
+}
+
+gen::Value
+Member::store(gen::Value val, gen::Value addr) const
+{
+    if (bitWidth) {
+	return gen::bitFieldStore(val, addr, type, bitOffset, bitWidth);
+    }
+    return Expr::store(val, addr);
+}
+
+// for traversing the expression tree
+void
+Member::apply(std::function<bool(const Expr *)> op) const
+{
+    if (op(this)) {
+	structure->apply(op);
+    }
+}
+
 // for debugging and educational purposes
 void
-Member::print(int indent) const
+Member::print(std::ostream &out, int indent) const
 {
     if (indent) {
-	std::cerr << std::setfill(' ') << std::setw(indent) << ' ';
+	out << std::setfill(' ') << std::setw(indent) << ' ';
     }
-    std::cerr << structure << (structure->type->isPointer() ? "->" : ".")
-              << member << " [ " << type << " ] " << std::endl;
+    out << structure << (structure->type->isPointer() ? "->" : ".")
+              << member << " [ " << type << " ] \n";
 }
 
 void
@@ -12,7 +12,8 @@ class Member : public Expr
 {
     protected:
 	Member(ExprPtr &&structure, UStr member, const Type *type,
-	       std::size_t index, lexer::Loc loc);
+	       std::size_t index, std::size_t bitOffset, std::size_t bitWidth,
+	       lexer::Loc loc);
 
     public:
 	static ExprPtr create(ExprPtr &&structure, bool derefStructPtr,
@@ -21,6 +22,8 @@ class Member : public Expr
 	const ExprPtr structure;
 	const UStr member;
 	const std::size_t index;
+	// for bit-fields: position in the storage unit at 'index'
+	const std::size_t bitOffset, bitWidth;
 
 	bool hasAddress() const override;
 	bool isLValue() const override;
@@ -30,9 +33,14 @@ class Member : public Expr
 	gen::Constant loadConstant() const override;
 	gen::Value loadValue() const override;
 	gen::Value loadAddress() const override;
+	gen::Value fetch(gen::Value addr) const override;
+	gen::Value store(gen::Value val, gen::Value addr) const override;
+
+	// for traversing the expression tree
+	void apply(std::function<bool(const Expr *)> op) const override;
 
 	// for debugging and educational purposes
-	void print(int indent) const override;
+	void print(std::ostream &out, int indent) const override;
 
 	// for printing error messages
 	virtual void printFlat(std::ostream &out, int prec) const override;
@@ -64,12 +64,12 @@ Nullptr::condition(gen::Label, gen::Label falseLabel) const
 
 // for debugging and educational purposes
 void
-Nullptr::print(int indent) const
+Nullptr::print(std::ostream &out, int indent) const
 {
     if (indent) {
-	std::cerr << std::setfill(' ') << std::setw(indent) << ' ';
+	out << std::setfill(' ') << std::setw(indent) << ' ';
     }
-    std::cerr << "nullptr" << std::endl;
+    out << "nullptr\n";
 }
 
 void
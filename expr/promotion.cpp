@@ -3,7 +3,9 @@
 #include "type/integertype.hpp"
 #include "type/pointertype.hpp"
 
+#include "identifier.hpp"
 #include "implicitcast.hpp"
+#include "member.hpp"
 #include "promotion.hpp"
 
 namespace abc {
@@ -52,7 +54,14 @@ call(ExprPtr &&fn, std::vector<ExprPtr> &&arg, lexer::Loc *loc)
     }
 
     for (std::size_t i = 0; i < arg.size(); ++i) {
-	if (i < paramType.size()) {
+	if (i < paramType.size() && fnType->paramIn()[i]) {
+	    // 'in' arguments are passed by reference, so only cast (and copy)
+	    // them if the types differ in more than the readonly qualifier
+	    auto argType = arg[i]->type->hasConstFlag()
+	                       ? paramType[i]
+	                       : paramType[i]->getConstRemoved();
+	    arg[i] = ImplicitCast::create(std::move(arg[i]), argType);
+	} else if (i < paramType.size()) {
 	    arg[i] = ImplicitCast::create(std::move(arg[i]), paramType[i]);
 	} else {
 	    // Rules for converting vargs:
@@ -87,17 +96,47 @@ static BinaryResult binaryArray(BinaryExpr::Kind kind, ExprPtr &&left,
                                 ExprPtr &&right, lexer::Loc *loc);
 static BinaryResult binaryStruct(BinaryExpr::Kind kind, ExprPtr &&left,
                                  ExprPtr &&right, lexer::Loc *loc);
+static BinaryResult binarySoaArray(BinaryExpr::Kind kind, ExprPtr &&left,
+                                   ExprPtr &&right, lexer::Loc *loc);
+
+// An element of a packed bool array is selected by its index in each load
+// and store. So it can only be read or assigned, otherwise a side effect of
+// the index would happen twice.
+static bool
+isPackedBoolElement(const ExprPtr &expr)
+{
+    auto binaryExpr = dynamic_cast<const BinaryExpr *>(expr.get());
+    return binaryExpr && binaryExpr->isPackedBoolElement();
+}
 
 BinaryResult
 binary(BinaryExpr::Kind kind, ExprPtr &&left, ExprPtr &&right, lexer::Loc *loc)
 {
-    if (left->type->isStruct() || right->type->isStruct()) {
+    if (kind > BinaryExpr::ASSIGN &&
+        kind <= BinaryExpr::BITWISE_RIGHT_SHIFT_ASSIGN &&
+        isPackedBoolElement(left)) {
+	if (loc) {
+	    error::location(left->loc);
+	    error::out() << error::setColor(error::BOLD) << left->loc << ": "
+	                 << error::setColor(error::BOLD_RED)
+	                 << "error: " << error::setColor(error::BOLD)
+	                 << "element of a packed array can only be assigned\n"
+	                 << error::setColor(error::NORMAL);
+	    error::fatal();
+	}
+	return std::make_tuple(std::move(left), std::move(right), nullptr);
+    }
+    if (left->type->isSoaArray() || right->type->isSoaArray() ||
+        left->type->isPackedBoolArray() || right->type->isPackedBoolArray()) {
+	return binarySoaArray(kind, std::move(left), std::move(right), loc);
+    } else if (left->type->isStruct() || right->type->isStruct()) {
 	return binaryStruct(kind, std::move(left), std::move(right), loc);
     } else if (left->type->isArray() || right->type->isArray()) {
 	return binaryArray(kind, std::move(left), std::move(right), loc);
     } else if (left->type->isPointer() || right->type->isPointer()) {
 	return binaryPtr(kind, std::move(left), std::move(right), loc);
-    } else if (left->type->isFloatType() || right->type->isFloatType()) {
+    } else if (left->type->isFloatType() || right->type->isFloatType() ||
+               left->type->isFixedPoint() || right->type->isFixedPoint()) {
 	return binaryFlt(kind, std::move(left), std::move(right), loc);
     } else if (left->type->isInteger() && right->type->isInteger()) {
 	return binaryInt(kind, std::move(left), std::move(right), loc);
@@ -217,10 +256,14 @@ static BinaryResult
 binaryFlt(BinaryExpr::Kind kind, ExprPtr &&left, ExprPtr &&right,
           lexer::Loc *loc)
 {
-    assert(left->type->isInteger() || left->type->isFloatType());
-    assert(right->type->isInteger() || right->type->isFloatType());
+    // also used for fixed-point types, these support the same operators
+    assert(left->type->isInteger() || left->type->isFloatType() ||
+           left->type->isFixedPoint());
+    assert(right->type->isInteger() || right->type->isFloatType() ||
+           right->type->isFixedPoint());
 
-    // when mixing integer and floating point: floating point wins
+    // when mixing integer and floating point: floating point wins,
+    // fixed-point wins over integer but not over floating point
     auto commonType = Type::common(left->type, right->type);
 
     const Type *type = nullptr;
@@ -377,7 +420,7 @@ binaryPtr(BinaryExpr::Kind kind, ExprPtr &&left, ExprPtr &&right,
 		             << "not an LValue\n"
 		             << error::setColor(error::NORMAL);
 	    } else {
-		type = IntegerType::createSigned(64);
+		type = IntegerType::createPtrdiffType();
 		newLeftType = left->type;
 		newRightType = right->type;
 	    }
@@ -391,7 +434,7 @@ binaryPtr(BinaryExpr::Kind kind, ExprPtr &&left, ExprPtr &&right,
 	break;
     case BinaryExpr::SUB:
 	if (left->type->isPointer() && right->type->isPointer()) {
-	    type = IntegerType::createSigned(64);
+	    type = IntegerType::createPtrdiffType();
 	    newLeftType = newRightType = Type::common(left->type, right->type);
 	} else if (left->type->isPointer() && right->type->isInteger()) {
 	    type = newLeftType = left->type;
@@ -520,6 +563,42 @@ binaryStruct(BinaryExpr::Kind kind, ExprPtr &&left, ExprPtr &&right,
     return std::make_tuple(std::move(left), std::move(right), left->type);
 }
 
+static BinaryResult
+binarySoaArray(BinaryExpr::Kind kind, ExprPtr &&left, ExprPtr &&right,
+               lexer::Loc *loc)
+{
+    //
+    // Unlike arrays soa arrays and packed bool arrays do not decay to a
+    // pointer. They can only be indexed or assigned as a whole.
+    //
+    switch (kind) {
+    case BinaryExpr::Kind::INDEX:
+	if (!left->type->isSoaArray() && !left->type->isPackedBoolArray()) {
+	    break;
+	} else if (!right->type->isInteger()) {
+	    error::location(right->loc);
+	    error::out() << error::setColor(error::BOLD) << right->loc << ": "
+	                 << error::setColor(error::BOLD_RED)
+	                 << "error: " << error::setColor(error::BOLD)
+	                 << "integer expression expected\n"
+	                 << error::setColor(error::NORMAL);
+	    error::fatal();
+	    break;
+	} else {
+	    auto elementType = left->type->refType();
+	    right = ImplicitCast::create(std::move(right),
+	                                 IntegerType::createSizeType());
+	    return std::make_tuple(std::move(left), std::move(right),
+	                           elementType);
+	}
+    case BinaryExpr::Kind::ASSIGN:
+	return binaryStruct(kind, std::move(left), std::move(right), loc);
+    default:
+	break;
+    }
+    return binaryErr(kind, std::move(left), std::move(right), loc);
+}
+
 /*
  * Rules for unary expressions
  */
@@ -529,6 +608,25 @@ using UnaryResult = std::pair<ExprPtr, const Type *>;
 static UnaryResult unaryErr(UnaryExpr::Kind kind, ExprPtr &&child,
                             lexer::Loc *loc);
 
+// 'in' parameter whose object (or a member or element of it) is denoted by
+// 'expr'
+static const Identifier *
+inParamObject(const Expr *expr)
+{
+    while (true) {
+	if (auto member = dynamic_cast<const Member *>(expr)) {
+	    expr = member->structure.get();
+	} else if (auto index = dynamic_cast<const BinaryExpr *>(expr);
+	           index && index->kind == BinaryExpr::INDEX &&
+	           index->left->type->isArray()) {
+	    expr = index->left.get();
+	} else {
+	    auto id = dynamic_cast<const Identifier *>(expr);
+	    return id && id->inParam ? id : nullptr;
+	}
+    }
+}
+
 UnaryResult
 unary(UnaryExpr::Kind kind, ExprPtr &&child, lexer::Loc *loc)
 {
@@ -538,6 +636,19 @@ unary(UnaryExpr::Kind kind, ExprPtr &&child, lexer::Loc *loc)
     default:
 	break;
     case UnaryExpr::ADDRESS:
+	// the address of an 'in' parameter is the address of the caller's
+	// object, which must not be captured by the callee
+	if (auto param = inParamObject(child.get())) {
+	    error::location(child->loc);
+	    error::out() << error::setColor(error::BOLD) << child->loc << ": "
+	                 << error::setColor(error::BOLD_RED)
+	                 << "error: " << error::setColor(error::BOLD)
+	                 << "address of 'in' parameter '" << param->name
+	                 << "' requested\n"
+	                 << error::setColor(error::NORMAL);
+	    error::fatal();
+	    break;
+	}
 	if (child->hasAddress()) {
 	    type = PointerType::create(child->type);
 	    newChildType = child->type;
@@ -575,7 +686,7 @@ unary(UnaryExpr::Kind kind, ExprPtr &&child, lexer::Loc *loc)
 	                 << error::setColor(error::NORMAL);
 	    break;
 	}
-	if (child->isLValue()) {
+	if (child->isLValue() && !isPackedBoolElement(child)) {
 	    if (child->type->isInteger() || child->type->isPointer()) {
 		type = newChildType = child->type;
 	    }
@@ -588,7 +699,8 @@ unary(UnaryExpr::Kind kind, ExprPtr &&child, lexer::Loc *loc)
 	}
 	break;
     case UnaryExpr::MINUS:
-	if (child->type->isInteger() || child->type->isFloatType()) {
+	if (child->type->isInteger() || child->type->isFloatType() ||
+	    child->type->isFixedPoint()) {
 	    type = newChildType = child->type;
 	}
 	break;
@@ -73,18 +73,18 @@ Sizeof::loadAddress() const
 
 // for debugging and educational purposes
 void
-Sizeof::print(int indent) const
+Sizeof::print(std::ostream &out, int indent) const
 {
     if (indent) {
-	std::cerr << std::setfill(' ') << std::setw(indent) << ' ';
+	out << std::setfill(' ') << std::setw(indent) << ' ';
     }
-    std::cerr << "sizeof ";
+    out << "sizeof ";
     if (sizeofType) {
-	std::cerr << sizeofType;
+	out << sizeofType;
     } else {
-	std::cerr << sizeofExpr;
+	out << sizeofExpr;
     }
-    std::cerr << " [ " << type << " ] " << std::endl;
+    out << " [ " << type << " ] \n";
 }
 
 void
@@ -83,12 +83,12 @@ StringLiteral::condition(gen::Label trueLabel, gen::Label) const
 
 // for debugging and educational purposes
 void
-StringLiteral::print(int indent) const
+StringLiteral::print(std::ostream &out, int indent) const
 {
     if (indent) {
-	std::cerr << std::setfill(' ') << std::setw(indent) << ' ';
+	out << std::setfill(' ') << std::setw(indent) << ' ';
     }
-    std::cerr << "\"" << val << "\" [ " << type << " ] " << std::endl;
+    out << "\"" << val << "\" [ " << type << " ] \n";
 }
 
 void
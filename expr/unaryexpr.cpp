@@ -137,32 +137,24 @@ UnaryExpr::loadValue() const
     case ADDRESS:
 	return child->loadAddress();
     case PREFIX_INC:
-    case PREFIX_DEC: {
-	auto incType =
-	    type->isPointer() ? IntegerType::createSigned(8) : child->type;
-	auto inc = kind == PREFIX_INC ? gen::getConstantInt(1, incType)
-	                              : gen::getConstantInt(-1, incType);
-	gen::Value val =
-	    type->isPointer()
-	        ? gen::pointerIncrement(child->type->refType(),
-	                                child->loadValue(), inc)
-	        : gen::instruction(gen::ADD, child->loadValue(), inc);
-	gen::store(val, child->loadAddress());
-	return val;
-    }
+    case PREFIX_DEC:
     case POSTFIX_INC:
     case POSTFIX_DEC: {
-	auto prevLeftVal = child->loadValue();
+	// the address of the operand is computed once and used for both the
+	// load and the store
+	auto addr = child->loadAddress();
+	auto prevVal = child->fetch(addr);
 	auto incType =
 	    type->isPointer() ? IntegerType::createSigned(8) : child->type;
-	auto inc = kind == POSTFIX_INC ? gen::getConstantInt(1, incType)
-	                               : gen::getConstantInt(-1, incType);
-	gen::Value val = type->isPointer()
-	                     ? gen::pointerIncrement(child->type->refType(),
-	                                             prevLeftVal, inc)
-	                     : gen::instruction(gen::ADD, prevLeftVal, inc);
-	gen::store(val, child->loadAddress());
-	return prevLeftVal;
+	auto inc = kind == PREFIX_INC || kind == POSTFIX_INC
+	               ? gen::getConstantInt(1, incType)
+	               : gen::getConstantInt(-1, incType);
+	gen::Value val =
+	    type->isPointer()
+	        ? gen::pointerIncrement(child->type->refType(), prevVal, inc)
+	        : gen::instruction(gen::ADD, prevVal, inc);
+	val = child->store(val, addr);
+	return kind == PREFIX_INC || kind == PREFIX_DEC ? val : prevVal;
     }
     case MINUS:
 	return gen::instruction(type->isFloatType() ? gen::FSUB : gen::SUB,
@@ -206,14 +198,23 @@ UnaryExpr::condition(gen::Label trueLabel, gen::Label falseLabel) const
     }
 }
 
+// for traversing the expression tree
+void
+UnaryExpr::apply(std::function<bool(const Expr *)> op) const
+{
+    if (op(this)) {
+	child->apply(op);
+    }
+}
+
 void
-UnaryExpr::print(int indent) const
+UnaryExpr::print(std::ostream &out, int indent) const
 {
     if (indent) {
-	std::cerr << std::setfill(' ') << std::setw(indent) << ' ';
+	out << std::setfill(' ') << std::setw(indent) << ' ';
     }
-    std::cerr << kindStr(kind) << " [ " << type << " ] " << std::endl;
-    child->print(indent + 4);
+    out << kindStr(kind) << " [ " << type << " ] \n";
+    child->print(out, indent + 4);
 }
 
 void
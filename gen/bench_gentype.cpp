@@ -0,0 +1,110 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "type/arraytype.hpp"
+#include "type/floattype.hpp"
+#include "type/functiontype.hpp"
+#include "type/inittypesystem.hpp"
+#include "type/integertype.hpp"
+#include "type/pointertype.hpp"
+#include "type/structtype.hpp"
+#include "util/bench.hpp"
+
+#include "gen.hpp"
+#include "gentype.hpp"
+
+// some struct with 'numMember' members of scalar and array type
+static const abc::Type *
+makeStruct(std::size_t id, std::size_t numMember)
+{
+    using namespace abc;
+
+    auto ty = StructType::createIncomplete(
+        UStr::create("S" + std::to_string(id)));
+
+    std::vector<UStr> memberName;
+    std::vector<std::size_t> memberIndex;
+    std::vector<const Type *> memberType;
+    for (std::size_t i = 0; i < numMember; ++i) {
+	memberName.push_back(UStr::create("m" + std::to_string(i)));
+	memberIndex.push_back(i);
+	memberType.push_back(i % 2 ? IntegerType::createInt()
+	                           : ArrayType::create(FloatType::createDouble(),
+	                                               i + 1));
+    }
+    return ty->complete(std::move(memberName), std::move(memberIndex),
+                        std::move(memberType), {});
+}
+
+static std::vector<const abc::Type *>
+randomTypes(std::mt19937_64 &rng, std::size_t num)
+{
+    using namespace abc;
+
+    std::uniform_int_distribution<int> kind(0, 5);
+    std::uniform_int_distribution<std::size_t> dim(1, 64);
+
+    std::vector<const Type *> ty;
+    for (std::size_t i = 0; i < num; ++i) {
+	switch (kind(rng)) {
+	case 0:
+	    ty.push_back(IntegerType::createSigned(8 << (i % 4)));
+	    break;
+	case 1:
+	    ty.push_back(FloatType::createDouble());
+	    break;
+	case 2:
+	    ty.push_back(PointerType::create(IntegerType::createChar()));
+	    break;
+	case 3:
+	    ty.push_back(ArrayType::create(IntegerType::createInt(), dim(rng)));
+	    break;
+	case 4:
+	    ty.push_back(FunctionType::create(IntegerType::createInt(),
+	                                      {FloatType::createDouble(),
+	                                       IntegerType::createLong()}));
+	    break;
+	default:
+	    ty.push_back(makeStruct(i, 1 + dim(rng) % 16));
+	}
+    }
+    return ty;
+}
+
+int
+main(int argc, char *argv[])
+{
+    using namespace abc;
+
+    bench::init(argc, argv);
+    std::mt19937_64 rng{bench::config.seed};
+    initTypeSystem();
+    gen::init("bench_gentype");
+
+    auto ty = randomTypes(rng, 4096);
+
+    bench::run(
+        "gen::convert miss", ty.size(), [] { gen::initTypeMap(); },
+        [&] {
+	    for (auto t : ty) {
+		bench::doNotOptimize(gen::convert(t));
+	    }
+        });
+
+    bench::run("gen::convert hit", ty.size(), [&] {
+	for (auto t : ty) {
+	    bench::doNotOptimize(gen::convert(t));
+	}
+    });
+
+    bench::run("gen::getSizeof", ty.size(), [&] {
+	for (auto t : ty) {
+	    if (!t->isFunction()) {
+		bench::doNotOptimize(gen::getSizeof(t));
+	    }
+	}
+    });
+
+    bench::report("gentype");
+}
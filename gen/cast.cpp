@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 #include "cast.hpp"
@@ -5,6 +7,85 @@
 
 namespace gen {
 
+// Fixed-point values are integers scaled by 2^fractionBits(). Conversions to
+// integers round towards zero, conversions from floating point values to the
+// nearest value.
+static Value
+castFixedPoint(Value val, const abc::Type *fromType, const abc::Type *toType)
+{
+    auto llvmToType = convert(toType);
+
+    if (fromType->isFixedPoint() && toType->isFixedPoint()) {
+	auto fromFrac = fromType->fractionBits();
+	auto toFrac = toType->fractionBits();
+	auto numBits = std::max(fromType->numBits(), toType->numBits());
+	auto llvmType = llvm::Type::getIntNTy(*llvmContext, numBits);
+	val = fromType->isSignedFixedPoint()
+	          ? llvmBuilder->CreateSExtOrBitCast(val, llvmType)
+	          : llvmBuilder->CreateZExtOrBitCast(val, llvmType);
+	if (toFrac > fromFrac) {
+	    val = llvmBuilder->CreateShl(val, toFrac - fromFrac);
+	} else if (toFrac < fromFrac) {
+	    val = fromType->isSignedFixedPoint()
+	              ? llvmBuilder->CreateAShr(val, fromFrac - toFrac)
+	              : llvmBuilder->CreateLShr(val, fromFrac - toFrac);
+	}
+	return llvmBuilder->CreateTruncOrBitCast(val, llvmToType);
+    } else if (fromType->isInteger() && toType->isFixedPoint()) {
+	if (toType->numBits() > fromType->numBits()) {
+	    val = fromType->isUnsignedInteger()
+	              ? llvmBuilder->CreateZExtOrBitCast(val, llvmToType)
+	              : llvmBuilder->CreateSExtOrBitCast(val, llvmToType);
+	} else {
+	    val = llvmBuilder->CreateTruncOrBitCast(val, llvmToType);
+	}
+	return llvmBuilder->CreateShl(val, toType->fractionBits());
+    } else if (fromType->isFixedPoint() && toType->isInteger()) {
+	auto numBits = fromType->numBits();
+	auto fracBits = fromType->fractionBits();
+	if (fracBits && fromType->isSignedFixedPoint()) {
+	    // add 2^fracBits - 1 to negative values before the shift
+	    auto sign = llvmBuilder->CreateAShr(val, numBits - 1);
+	    auto bias = llvmBuilder->CreateLShr(sign, numBits - fracBits);
+	    val = llvmBuilder->CreateAShr(llvmBuilder->CreateAdd(val, bias),
+	                                  fracBits);
+	} else if (fracBits) {
+	    val = llvmBuilder->CreateLShr(val, fracBits);
+	}
+	if (toType->numBits() > numBits) {
+	    return fromType->isSignedFixedPoint()
+	               ? llvmBuilder->CreateSExtOrBitCast(val, llvmToType)
+	               : llvmBuilder->CreateZExtOrBitCast(val, llvmToType);
+	} else {
+	    return llvmBuilder->CreateTruncOrBitCast(val, llvmToType);
+	}
+    } else if (fromType->isFloatType() && toType->isFixedPoint()) {
+	auto llvmFromType = convert(fromType);
+	auto scale = llvm::ConstantFP::get(
+	    llvmFromType, std::ldexp(1.0, toType->fractionBits()));
+	val = llvmBuilder->CreateFMul(val, scale);
+	auto half = llvm::ConstantFP::get(llvmFromType, 0.5);
+	if (toType->isSignedFixedPoint()) {
+	    auto zero = llvm::ConstantFP::get(llvmFromType, 0.0);
+	    auto isNeg = llvmBuilder->CreateFCmpOLT(val, zero);
+	    auto minusHalf = llvm::ConstantFP::get(llvmFromType, -0.5);
+	    val = llvmBuilder->CreateFAdd(
+	        val, llvmBuilder->CreateSelect(isNeg, minusHalf, half));
+	    return llvmBuilder->CreateFPToSI(val, llvmToType);
+	}
+	val = llvmBuilder->CreateFAdd(val, half);
+	return llvmBuilder->CreateFPToUI(val, llvmToType);
+    } else if (fromType->isFixedPoint() && toType->isFloatType()) {
+	val = fromType->isSignedFixedPoint()
+	          ? llvmBuilder->CreateSIToFP(val, llvmToType)
+	          : llvmBuilder->CreateUIToFP(val, llvmToType);
+	auto scale = llvm::ConstantFP::get(
+	    llvmToType, std::ldexp(1.0, -int(fromType->fractionBits())));
+	return llvmBuilder->CreateFMul(val, scale);
+    }
+    return nullptr;
+}
+
 Value
 cast(Value val, const abc::Type *fromType, const abc::Type *toType)
 {
@@ -21,7 +102,11 @@ cast(Value val, const abc::Type *fromType, const abc::Type *toType)
 
     auto llvmToType = convert(toType);
 
-    if (fromType->isInteger() && toType->isInteger()) {
+    if (fromType->isFixedPoint() || toType->isFixedPoint()) {
+	if (auto result = castFixedPoint(val, fromType, toType)) {
+	    return result;
+	}
+    } else if (fromType->isInteger() && toType->isInteger()) {
 	if (toType->numBits() > fromType->numBits()) {
 	    return fromType->isUnsignedInteger()
 	               ? llvmBuilder->CreateZExtOrBitCast(val, llvmToType)
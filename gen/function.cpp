@@ -55,13 +55,31 @@ functionDeclaration(const char *ident, const abc::Type *fnType,
 
     auto fn =
         llvm::Function::Create(llvmFnType, linkage, ident, llvmModule.get());
+
+    // 'in' parameters: the callee only reads the caller's object, nothing
+    // else modifies it during the call, and the address can not be taken
+    for (std::size_t i = 0; i < fnType->paramType().size(); ++i) {
+	if (!fnType->paramIn()[i]) {
+	    continue;
+	}
+	auto size = getSizeof(fnType->paramType()[i]);
+	fn->addParamAttr(i, llvm::Attribute::NoAlias);
+	fn->addParamAttr(i, llvm::Attribute::ReadOnly);
+#if LLVM_MAJOR_VERSION >= 21
+	fn->addParamAttr(i, llvm::Attribute::getWithCaptureInfo(
+	                        *llvmContext, llvm::CaptureInfo::none()));
+#else
+	fn->addParamAttr(i, llvm::Attribute::NoCapture);
+#endif
+	fn->addDereferenceableParamAttr(i, size);
+    }
     return fn;
 }
 
 void
 functionDefinitionBegin(const char *ident, const abc::Type *fnType,
                         const std::vector<const char *> &param,
-                        bool externalLinkage)
+                        bool externalLinkage, bool fastMath)
 {
     assert(param.size() == fnType->paramType().size());
 
@@ -70,6 +88,9 @@ functionDefinitionBegin(const char *ident, const abc::Type *fnType,
     fn->setDoesNotThrow();
     llvmBB = llvm::BasicBlock::Create(*llvmContext, "entry", fn);
     llvmBuilder->SetInsertPoint(llvmBB);
+    if (fastMath) {
+	llvmBuilder->setFastMathFlags(llvm::FastMathFlags::getFast());
+    }
 
     auto retType = fnType->retType();
 
@@ -84,9 +105,16 @@ functionDefinitionBegin(const char *ident, const abc::Type *fnType,
     functionBuildingInfo.retType = retType;
     functionBuildingInfo.retVal = nullptr;
     functionBuildingInfo.bbClosed = false;
+    functionBuildingInfo.namedLabel.clear();
+    functionBuildingInfo.addressTaken.clear();
+    functionBuildingInfo.indirectJump.clear();
 
     for (std::size_t i = 0; i < param.size(); ++i) {
 	// std::cerr << ">> i = " << i << "\n";
+	if (fnType->paramIn()[i]) {
+	    localReferenceDefinition(param[i], fn->getArg(i));
+	    continue;
+	}
 	auto addr = localVariableDefinition(param[i], fnType->paramType()[i]);
 	store(fn->getArg(i), addr);
     }
@@ -113,6 +141,13 @@ functionDefinitionEnd()
 
     bool wellFormed = true;
 
+    // an indirect jump can reach every label whose address was taken
+    for (auto jump : functionBuildingInfo.indirectJump) {
+	for (auto label : functionBuildingInfo.addressTaken) {
+	    jump->addDestination(label);
+	}
+    }
+
     auto checkReturn = getLabel("checkReturn");
     if (!functionBuildingInfo.bbClosed) {
 	jumpInstruction(checkReturn);
@@ -156,6 +191,7 @@ functionDefinitionEnd()
     }
 
     llvm::verifyFunction(*functionBuildingInfo.fn);
+    llvmBuilder->setFastMathFlags(opt::getFastMathFlags());
 
     functionBuildingInfo.fn = nullptr;
     functionBuildingInfo.leave = nullptr;
@@ -1,12 +1,16 @@
 #ifndef GEN_FUNCTION
 #define GEN_FUNCTION
 
+#include <unordered_map>
+#include <vector>
+
 #ifdef SUPPORT_SOLARIS
 // has to be included as first llvm header
 #include "llvm/Support/Solaris/sys/regset.h"
 #endif // SUPPORT_SOLARIS
 
 #include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
 
 #include "type/type.hpp"
 
@@ -22,6 +26,12 @@ struct FunctionBuildingInfo
 	Value retVal = nullptr;
 	bool bbClosed = true;
 	bool isMain = false;
+
+	// labels as values: labels by name, labels whose address was taken
+	// and indirect jumps, which can reach all of these labels
+	std::unordered_map<const char *, Label> namedLabel;
+	std::vector<Label> addressTaken;
+	std::vector<llvm::IndirectBrInst *> indirectJump;
 };
 
 extern FunctionBuildingInfo functionBuildingInfo;
@@ -33,9 +43,10 @@ bool bbOpen();
 llvm::Function *functionDeclaration(const char *ident, const abc::Type *fnType,
                                     bool externalLinkage);
 
+// 'fastMath' enables all fast-math flags for this function only
 void functionDefinitionBegin(const char *ident, const abc::Type *fnType,
                              const std::vector<const char *> &arg,
-                             bool externalLinkage);
+                             bool externalLinkage, bool fastMath = false);
 
 bool functionDefinitionEnd();
 
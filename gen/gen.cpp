@@ -14,19 +14,50 @@
 #include "gentype.hpp"
 #include "variable.hpp"
 
+#include "type/integertype.hpp"
+
 namespace gen {
 
 std::unique_ptr<llvm::LLVMContext> llvmContext;
 std::unique_ptr<llvm::Module> llvmModule;
 std::unique_ptr<llvm::IRBuilder<>> llvmBuilder;
 llvm::BasicBlock *llvmBB;
-llvm::TargetMachine *targetMachine;
+std::unique_ptr<llvm::TargetMachine> targetMachine;
 
 namespace opt {
 
 std::string target;
 std::string mcu;
 
+bool discardValueNames;
+
+bool functionSections;
+bool dataSections;
+
+bool fastMath;
+bool associativeMath;
+bool honorNans = true;
+FpContract fpContract = FP_CONTRACT_OFF;
+
+llvm::FastMathFlags
+getFastMathFlags()
+{
+    llvm::FastMathFlags fmf;
+    if (fastMath) {
+	fmf.setFast();
+    }
+    if (associativeMath) {
+	fmf.setAllowReassoc();
+    }
+    if (!honorNans) {
+	fmf.setNoNaNs();
+    }
+    if (fpContract == FP_CONTRACT_FAST) {
+	fmf.setAllowContract();
+    }
+    return fmf;
+}
+
 } // namespace opt
 
 const char *moduleName;
@@ -110,6 +141,17 @@ getFeatures()
     return "";
 }
 
+static llvm::FPOpFusion::FPOpFusionMode
+getFPOpFusion()
+{
+    if (opt::fastMath || opt::fpContract == opt::FP_CONTRACT_FAST) {
+	return llvm::FPOpFusion::Fast;
+    } else if (opt::fpContract == opt::FP_CONTRACT_ON) {
+	return llvm::FPOpFusion::Standard;
+    }
+    return llvm::FPOpFusion::Strict;
+}
+
 static llvm::Reloc::Model
 getRelocModel(const std::string &targetTriple)
 {
@@ -126,11 +168,16 @@ init(const char *name, llvm::OptimizationLevel optLevel)
     initTypeMap();
     moduleName = name ? name : "llvm";
 
-    if (!llvmContext) {
-	llvmContext = std::make_unique<llvm::LLVMContext>();
-    }
+    // release the previous module before its context: each module gets a
+    // fresh context so that types and constants do not accumulate across
+    // input files
+    llvmBuilder.reset();
+    llvmModule.reset();
+    llvmContext = std::make_unique<llvm::LLVMContext>();
+    llvmContext->setDiscardValueNames(opt::discardValueNames);
     llvmModule = std::make_unique<llvm::Module>(moduleName, *llvmContext);
     llvmBuilder = std::make_unique<llvm::IRBuilder<>>(*llvmContext);
+    llvmBuilder->setFastMathFlags(opt::getFastMathFlags());
     llvmBB = nullptr;
 
     llvm::InitializeAllTargetInfos();
@@ -151,15 +198,26 @@ init(const char *name, llvm::OptimizationLevel optLevel)
     }
 
     llvm::TargetOptions topts{};
+    topts.AllowFPOpFusion = getFPOpFusion();
+    topts.FunctionSections = opt::functionSections;
+    topts.DataSections = opt::dataSections;
     auto relocModel = getRelocModel(tripleStr);
     auto codeModel = std::optional<llvm::CodeModel::Model>();
     llvm::CodeGenOptLevel cgOpt = mapOpt(optLevel);
 
     auto cpu = getCpu();
-    targetMachine = target->createTargetMachine(TT, cpu, getFeatures(), topts,
-                                                relocModel, codeModel, cgOpt);
+    targetMachine.reset(target->createTargetMachine(
+        TT, cpu, getFeatures(), topts, relocModel, codeModel, cgOpt));
 
     llvmModule->setDataLayout(targetMachine->createDataLayout());
+
+    // int is 16 bits wide on 16-bit targets (e.g. AVR, MSP430) and long is
+    // 64 bits wide on 64-bit targets except Windows (LLP64). size_t and
+    // ptrdiff_t have the width of a pointer.
+    std::size_t intBits = TT.isArch16Bit() ? 16 : 32;
+    std::size_t longBits = TT.isArch64Bit() && !TT.isOSWindows() ? 64 : 32;
+    std::size_t sizeBits = llvmModule->getDataLayout().getPointerSizeInBits();
+    abc::IntegerType::setTargetWidths(intBits, longBits, sizeBits);
 }
 
 llvm::OptimizationLevel
@@ -30,13 +30,37 @@ extern std::unique_ptr<llvm::LLVMContext> llvmContext;
 extern std::unique_ptr<llvm::Module> llvmModule;
 extern std::unique_ptr<llvm::IRBuilder<>> llvmBuilder;
 extern llvm::BasicBlock *llvmBB;
-extern llvm::TargetMachine *targetMachine;
+extern std::unique_ptr<llvm::TargetMachine> targetMachine;
 
 namespace opt {
 
 extern std::string target;
 extern std::string mcu;
 
+// drop names of local values and local variable identifiers
+extern bool discardValueNames;
+
+// put each function and global variable into a section of its own, so that
+// the linker can discard unused ones
+extern bool functionSections;
+extern bool dataSections;
+
+// floating-point code generation
+enum FpContract
+{
+    FP_CONTRACT_OFF,  // never fuse a * b + c
+    FP_CONTRACT_ON,   // fuse a * b + c within an expression
+    FP_CONTRACT_FAST, // fuse whenever profitable
+};
+
+extern bool fastMath;
+extern bool associativeMath;
+extern bool honorNans;
+extern FpContract fpContract;
+
+// fast-math flags for floating-point instructions of the whole module
+llvm::FastMathFlags getFastMathFlags();
+
 } // namespace opt
 
 extern const char *moduleName;
@@ -3,6 +3,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include "type/integertype.hpp"
+
 #include "gen.hpp"
 #include "gentype.hpp"
 
@@ -62,10 +64,19 @@ convert(const abc::Type *abcType)
 	    llvmType = llvm::Type::getIntNTy(*llvmContext, abcType->numBits());
 	    break;
 	}
+    } else if (abcType->isFixedPoint()) {
+	// stored as scaled integer
+	llvmType = llvm::Type::getIntNTy(*llvmContext, abcType->numBits());
     } else if (abcType->isFunction()) {
+	// 'in' parameters are passed by reference
+	auto llvmParamType = convert(abcType->paramType());
+	for (std::size_t i = 0; i < llvmParamType.size(); ++i) {
+	    if (abcType->paramIn()[i]) {
+		llvmParamType[i] = llvm::PointerType::get(*llvmContext, 0);
+	    }
+	}
 	llvmType = llvm::FunctionType::get(convert(abcType->retType()),
-	                                   convert(abcType->paramType()),
-	                                   abcType->hasVarg());
+	                                   llvmParamType, abcType->hasVarg());
     } else if (abcType->isPointer()) {
 	llvmType = llvm::PointerType::get(*llvmContext, 0);
     } else if (abcType->isArray()) {
@@ -87,6 +98,21 @@ convert(const abc::Type *abcType)
 	    }
 	}
 	llvmType = llvm::StructType::get(*llvmContext, llvmMemberType);
+    } else if (abcType->isPackedBoolArray()) {
+	auto wordType = abc::IntegerType::createSizeType();
+	auto bits = wordType->numBits();
+	llvmType = llvm::ArrayType::get(convert(wordType),
+	                                (abcType->dim() + bits - 1) / bits);
+    } else if (abcType->isSoaArray()) {
+	// one array for each member of the (union-merged) struct layout
+	auto llvmStructType =
+	    llvm::cast<llvm::StructType>(convert(abcType->refType()));
+	std::vector<llvm::Type *> llvmMemberType;
+	for (auto llvmElementType : llvmStructType->elements()) {
+	    llvmMemberType.push_back(
+	        llvm::ArrayType::get(llvmElementType, abcType->dim()));
+	}
+	llvmType = llvm::StructType::get(*llvmContext, llvmMemberType);
     } else {
 	std::cerr << "gen::convert with type '" << abcType << "'\n";
 	assert(0);
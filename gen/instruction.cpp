@@ -1,3 +1,6 @@
+#include "type/integertype.hpp"
+#include "util/stats.hpp"
+
 #include "function.hpp"
 #include "gentype.hpp"
 #include "instruction.hpp"
@@ -6,6 +9,48 @@
 
 namespace gen {
 
+// A multiplication that was just generated for the current expression and is
+// not used anywhere else
+static llvm::BinaryOperator *
+contractableMul(Value val)
+{
+    auto mul = llvm::dyn_cast<llvm::BinaryOperator>(val);
+    if (!mul || mul->getOpcode() != llvm::Instruction::FMul ||
+        !mul->use_empty()) {
+	return nullptr;
+    }
+    return mul;
+}
+
+// For -ffp-contract=on: replaces 'a * b + c', 'a * b - c' and 'c - a * b' by
+// a call of llvm.fmuladd. Returns nullptr if the operation can not be fused.
+static Value
+fuseMulAdd(InstructionOp op, Value left, Value right)
+{
+    if (opt::fpContract != opt::FP_CONTRACT_ON || left == right) {
+	return nullptr;
+    }
+    auto mul = contractableMul(left);
+    if (!mul) {
+	mul = contractableMul(right);
+    }
+    if (!mul) {
+	return nullptr;
+    }
+
+    Value a = mul->getOperand(0);
+    Value b = mul->getOperand(1);
+    Value c = mul == left ? right : left;
+    if (op == FSUB && mul == left) {
+	c = llvmBuilder->CreateFNeg(c);
+    } else if (op == FSUB) {
+	a = llvmBuilder->CreateFNeg(a);
+    }
+    mul->eraseFromParent();
+    return llvmBuilder->CreateIntrinsic(llvm::Intrinsic::fmuladd,
+                                        {a->getType()}, {a, b, c});
+}
+
 static Value
 instruction(InstructionOp op, Value left, Value right, bool forConstValue)
 {
@@ -13,6 +58,11 @@ instruction(InstructionOp op, Value left, Value right, bool forConstValue)
 
     if (!forConstValue) {
 	reachableCheck();
+	if (op == FADD || op == FSUB) {
+	    if (auto fused = fuseMulAdd(op, left, right)) {
+		return fused;
+	    }
+	}
     }
 
     switch (op) {
@@ -100,9 +150,73 @@ instruction(InstructionOp op, Constant left, Constant right)
 {
     auto left_ = llvm::dyn_cast<llvm::Value>(left);
     auto right_ = llvm::dyn_cast<llvm::Value>(right);
+    abc::stats::count(abc::stats::CONSTANT_FOLDS);
     return llvm::dyn_cast<llvm::Constant>(instruction(op, left_, right_, true));
 }
 
+static Value
+fixedPointInstruction(InstructionOp op, Value left, Value right,
+                      const abc::Type *type, bool forConstValue)
+{
+    assert(llvmContext);
+    assert(type->isFixedPoint());
+
+    if (!forConstValue) {
+	reachableCheck();
+    }
+
+    auto numBits = type->numBits();
+    auto fracBits = type->fractionBits();
+    auto isSigned = type->isSignedFixedPoint();
+    auto llvmType = convert(type);
+    auto llvmWideType = llvm::Type::getIntNTy(*llvmContext, 2 * numBits);
+
+    if (isSigned) {
+	left = llvmBuilder->CreateSExt(left, llvmWideType);
+	right = llvmBuilder->CreateSExt(right, llvmWideType);
+    } else {
+	left = llvmBuilder->CreateZExt(left, llvmWideType);
+	right = llvmBuilder->CreateZExt(right, llvmWideType);
+    }
+
+    Value result = nullptr;
+    switch (op) {
+    case SMUL:
+	result = llvmBuilder->CreateMul(left, right);
+	result = isSigned ? llvmBuilder->CreateAShr(result, fracBits)
+	                  : llvmBuilder->CreateLShr(result, fracBits);
+	break;
+    case SDIV:
+    case UDIV:
+	left = llvmBuilder->CreateShl(left, fracBits);
+	result = isSigned ? llvmBuilder->CreateSDiv(left, right)
+	                  : llvmBuilder->CreateUDiv(left, right);
+	break;
+    default:
+	assert(0);
+	return nullptr;
+    }
+    return llvmBuilder->CreateTrunc(result, llvmType);
+}
+
+Value
+fixedPointInstruction(InstructionOp op, Value left, Value right,
+                      const abc::Type *type)
+{
+    return fixedPointInstruction(op, left, right, type, false);
+}
+
+Constant
+fixedPointInstruction(InstructionOp op, Constant left, Constant right,
+                      const abc::Type *type)
+{
+    auto left_ = llvm::dyn_cast<llvm::Value>(left);
+    auto right_ = llvm::dyn_cast<llvm::Value>(right);
+    abc::stats::count(abc::stats::CONSTANT_FOLDS);
+    return llvm::dyn_cast<llvm::Constant>(
+        fixedPointInstruction(op, left_, right_, type, true));
+}
+
 JumpOrigin
 jumpInstruction(Label label)
 {
@@ -129,6 +243,21 @@ jumpInstruction(Value condition, Label trueLabel, Label falseLabel)
     return ib;
 }
 
+JumpOrigin
+indirectJumpInstruction(Value addr)
+{
+    assert(llvmBuilder);
+    assert(functionBuildingInfo.fn);
+    reachableCheck();
+
+    // destinations are added by functionDefinitionEnd()
+    auto ib = llvmBuilder->GetInsertBlock();
+    auto jump = llvmBuilder->CreateIndirectBr(addr);
+    functionBuildingInfo.indirectJump.push_back(jump);
+    functionBuildingInfo.bbClosed = true;
+    return ib;
+}
+
 JumpOrigin
 jumpInstruction(Value condition, Label defaultLabel,
                 const std::vector<CaseLabel> &caseLabel)
@@ -147,6 +276,17 @@ jumpInstruction(Value condition, Label defaultLabel,
     return ib;
 }
 
+Value
+bitCount(Value val)
+{
+    assert(llvmBuilder);
+    reachableCheck();
+
+    auto count = llvmBuilder->CreateUnaryIntrinsic(llvm::Intrinsic::ctpop, val);
+    auto sizeType = convert(abc::IntegerType::createSizeType());
+    return llvmBuilder->CreateZExtOrTrunc(count, sizeType);
+}
+
 Value
 phi(Value a, Label labelA, Value b, Label labelB, const abc::Type *type)
 {
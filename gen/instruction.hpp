@@ -48,13 +48,27 @@ enum InstructionOp
 Value instruction(InstructionOp op, Value left, Value right);
 Constant instruction(InstructionOp op, Constant left, Constant right);
 
+// for fixed-point 'type' and op SMUL, SDIV or UDIV: the operation is done with
+// twice the number of bits and the result is scaled back. Other operations
+// can be done with instruction() on the scaled integers.
+Value fixedPointInstruction(InstructionOp op, Value left, Value right,
+                            const abc::Type *type);
+Constant fixedPointInstruction(InstructionOp op, Constant left,
+                               Constant right, const abc::Type *type);
+
 JumpOrigin jumpInstruction(Label label);
 JumpOrigin jumpInstruction(Value condition, Label trueLabel, Label falseLabel);
 
+// jump to the label with address 'addr', see labelAddress()
+JumpOrigin indirectJumpInstruction(Value addr);
+
 using CaseLabel = std::pair<ConstantInt, Label>;
 JumpOrigin jumpInstruction(Value condition, Label defaultLabel,
                            const std::vector<CaseLabel> &caseLabel);
 
+// number of set bits of the integer 'val' as size_t value
+Value bitCount(Value val);
+
 Value phi(Value a, Label labelA, Value b, Label labelB, const abc::Type *type);
 
 void returnInstruction(Value val);
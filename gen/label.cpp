@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "function.hpp"
 #include "instruction.hpp"
 #include "label.hpp"
@@ -20,9 +22,50 @@ defineLabel(Label label)
 	jumpInstruction(label);
     }
 
-    functionBuildingInfo.fn->insert(functionBuildingInfo.fn->end(), label);
+    auto fn = functionBuildingInfo.fn;
+    if (!label->getParent()) {
+	fn->insert(fn->end(), label);
+    } else if (label != &fn->back()) {
+	// already inserted by labelAddress()
+	label->moveAfter(&fn->back());
+    }
     llvmBuilder->SetInsertPoint(label);
     functionBuildingInfo.bbClosed = false;
 }
 
+void
+declareLabelName(const char *name, Label label)
+{
+    functionBuildingInfo.namedLabel[name] = label;
+}
+
+Label
+findLabel(const char *name)
+{
+    if (!functionBuildingInfo.fn) {
+	return nullptr;
+    }
+    auto found = functionBuildingInfo.namedLabel.find(name);
+    return found != functionBuildingInfo.namedLabel.end() ? found->second
+                                                           : nullptr;
+}
+
+Constant
+labelAddress(Label label)
+{
+    assert(functionBuildingInfo.fn);
+    auto fn = functionBuildingInfo.fn;
+    auto &addressTaken = functionBuildingInfo.addressTaken;
+    if (std::find(addressTaken.begin(), addressTaken.end(), label) ==
+        addressTaken.end()) {
+	addressTaken.push_back(label);
+    }
+    // a block address requires a block within the function, its position
+    // is fixed when the label gets defined
+    if (!label->getParent()) {
+	fn->insert(fn->end(), label);
+    }
+    return llvm::BlockAddress::get(fn, label);
+}
+
 } // namespace gen
@@ -9,6 +9,14 @@ Label getLabel(const char *name = "");
 
 void defineLabel(Label label);
 
+// labels of the current function that can be referenced by name, e.g. in
+// '&&name'. Outside of a function no label is found.
+void declareLabelName(const char *name, Label label);
+Label findLabel(const char *name);
+
+// address of 'label' (in the current function) for an indirect jump
+Constant labelAddress(Label label);
+
 } // namespace gen
 
 #endif // GEN_LABEL_HPP
@@ -1,38 +1,36 @@
+#include <algorithm>
+#include <chrono>
+#include <string>
 #include <system_error>
+#include <unordered_set>
 
 #ifdef SUPPORT_SOLARIS
 // has to be included as first llvm header
 #include "llvm/Support/Solaris/sys/regset.h"
 #endif // SUPPORT_SOLARIS
 
+#include "llvm/Config/llvm-config.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Transforms/Utils/Cloning.h"
 
 #include "gen.hpp"
 #include "print.hpp"
 
 namespace gen {
 
-void
-print(std::filesystem::path path, FileType fileType)
+static void
+optimize(llvm::Module &module)
 {
-    assert(llvmContext);
-    assert(targetMachine);
-    std::error_code ec;
-    auto f = llvm::raw_fd_ostream{path.c_str(), ec, llvm::sys::fs::OF_None};
-
-    if (ec) {
-	llvm::errs() << "Could not open file: " << path << ". " << ec.message()
-	             << "\n";
-	std::exit(1);
-    }
-
     llvm::LoopAnalysisManager LAM;
     llvm::FunctionAnalysisManager FAM;
     llvm::CGSCCAnalysisManager CGAM;
     llvm::ModuleAnalysisManager MAM;
 
-    llvm::PassBuilder PB{targetMachine};
+    llvm::PassBuilder PB{targetMachine.get()};
     PB.registerModuleAnalyses(MAM);
     PB.registerCGSCCAnalyses(CGAM);
     PB.registerFunctionAnalyses(FAM);
@@ -41,13 +39,12 @@ print(std::filesystem::path path, FileType fileType)
 
     llvm::ModulePassManager MPM =
         PB.buildPerModuleDefaultPipeline(getOptimizationLevel());
-    MPM.run(*llvmModule, MAM);
-
-    if (fileType == LLVM_FILE) {
-	llvmModule->print(f, nullptr);
-	return;
-    }
+    MPM.run(module, MAM);
+}
 
+static void
+emit(llvm::Module &module, llvm::raw_pwrite_stream &f, FileType fileType)
+{
     llvm::legacy::PassManager pass;
     auto llvmFileType = fileType == OBJECT_FILE
 #if LLVM_MAJOR_VERSION >= 18
@@ -62,8 +59,317 @@ print(std::filesystem::path path, FileType fileType)
 	llvm::errs() << "can't emit a file of this type";
 	std::exit(1);
     }
-    pass.run(*llvmModule);
+    pass.run(module);
     f.flush();
 }
 
+void
+print(std::filesystem::path path, FileType fileType)
+{
+    assert(llvmContext);
+    assert(targetMachine);
+    std::error_code ec;
+    auto f = llvm::raw_fd_ostream{path.c_str(), ec, llvm::sys::fs::OF_None};
+
+    if (ec) {
+	llvm::errs() << "Could not open file: " << path << ". " << ec.message()
+	             << "\n";
+	std::exit(1);
+    }
+
+    optimize(*llvmModule);
+
+    if (fileType == LLVM_FILE) {
+	llvmModule->print(f, nullptr);
+	return;
+    }
+    emit(*llvmModule, f, fileType);
+}
+
+//------------------------------------------------------------------------------
+
+/*
+ * Incremental compilation: the module is split into one part per function
+ * definition and one part with all global variable definitions. Each part is
+ * a module of its own that declares everything it references. Parts are
+ * keyed by a hash of their (unoptimized) IR and the target configuration, so
+ * a part only has to be optimized and compiled if the function itself, a
+ * signature or type it refers to, or (when optimizing) an inlinable callee
+ * has changed.
+ */
+
+static std::string
+md5(const std::string &s)
+{
+    llvm::MD5 hash;
+    hash.update(s);
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+    return std::string{result.digest()};
+}
+
+// private constants with an insignificant address (e.g. string literals) are
+// copied into each part that uses them
+static bool
+isCopiedConstant(const llvm::GlobalValue &gv)
+{
+    auto var = llvm::dyn_cast<llvm::GlobalVariable>(&gv);
+    return var && var->hasLocalLinkage() && var->isConstant() &&
+           var->hasGlobalUnnamedAddr();
+}
+
+// function whose labels are referenced by a global variable (e.g. a 'static'
+// table of label addresses), the variable has to be in the part of the
+// function
+static const llvm::Function *
+blockAddressFunction(const llvm::Constant *c)
+{
+    if (auto addr = llvm::dyn_cast<llvm::BlockAddress>(c)) {
+	return addr->getFunction();
+    } else if (llvm::isa<llvm::GlobalValue>(c)) {
+	return nullptr;
+    }
+    for (const auto &op : c->operands()) {
+	if (auto fn = blockAddressFunction(llvm::cast<llvm::Constant>(op))) {
+	    return fn;
+	}
+    }
+    return nullptr;
+}
+
+static const llvm::Function *
+blockAddressFunction(const llvm::GlobalValue &gv)
+{
+    auto var = llvm::dyn_cast<llvm::GlobalVariable>(&gv);
+    return var && var->hasInitializer()
+               ? blockAddressFunction(var->getInitializer())
+               : nullptr;
+}
+
+// all other symbols with internal linkage are referenced across parts: they
+// become hidden globals with a name that is unique for this object file
+static void
+promoteLocals(llvm::Module &module, const std::string &suffix)
+{
+    for (auto &gv : module.global_values()) {
+	if (gv.hasLocalLinkage() && !isCopiedConstant(gv)) {
+	    gv.setName(gv.getName() + suffix);
+	    gv.setLinkage(llvm::GlobalValue::ExternalLinkage);
+	    gv.setVisibility(llvm::GlobalValue::HiddenVisibility);
+	}
+    }
+}
+
+// part with the definition of 'fn', or with all global variable definitions
+// if 'fn' is null
+static std::unique_ptr<llvm::Module>
+extractPart(const llvm::Module &module, const llvm::Function *fn)
+{
+    // when optimizing, direct callees are kept as 'available_externally' so
+    // that they still can be inlined
+    std::unordered_set<const llvm::Function *> callee;
+    if (fn && getOptimizationLevel() != llvm::OptimizationLevel::O0) {
+	for (const auto &inst : llvm::instructions(fn)) {
+	    if (auto call = llvm::dyn_cast<llvm::CallBase>(&inst)) {
+		auto f = call->getCalledFunction();
+		if (f && f != fn && !f->isDeclaration()) {
+		    callee.insert(f);
+		}
+	    }
+	}
+    }
+
+    llvm::ValueToValueMapTy vmap;
+    auto part = llvm::CloneModule(
+        module, vmap, [&](const llvm::GlobalValue *gv) {
+	    if (auto f = llvm::dyn_cast<llvm::Function>(gv)) {
+		return f == fn || callee.contains(f);
+	    } else if (auto f = blockAddressFunction(*gv)) {
+		return f == fn;
+	    }
+	    return !fn || isCopiedConstant(*gv);
+        });
+    for (auto f : callee) {
+	llvm::cast<llvm::Function>(vmap[f])->setLinkage(
+	    llvm::GlobalValue::AvailableExternallyLinkage);
+    }
+
+    // drop everything this part does not refer to
+    for (bool changed = true; changed;) {
+	changed = false;
+	for (auto &f : llvm::make_early_inc_range(part->functions())) {
+	    f.removeDeadConstantUsers();
+	    if (f.use_empty() &&
+	        (f.isDeclaration() || f.hasAvailableExternallyLinkage())) {
+		f.eraseFromParent();
+		changed = true;
+	    }
+	}
+	for (auto &var : llvm::make_early_inc_range(part->globals())) {
+	    var.removeDeadConstantUsers();
+	    if (var.use_empty() &&
+	        (var.isDeclaration() || isCopiedConstant(var))) {
+		var.eraseFromParent();
+		changed = true;
+	    }
+	}
+    }
+    return part;
+}
+
+// identifies the compiler, so that parts compiled by another build of abc or
+// another LLVM are not reused
+static const std::string &
+compilerId()
+{
+    static const std::string id = [] {
+	auto exe = llvm::sys::fs::getMainExecutable(
+	    nullptr, reinterpret_cast<void *>(std::intptr_t(&compilerId)));
+	std::error_code ec;
+	auto time = std::filesystem::last_write_time(exe, ec);
+	auto bytes = std::filesystem::file_size(exe, ec);
+	return exe + " " + std::to_string(time.time_since_epoch().count()) +
+	       " " + std::to_string(bytes) + " LLVM " + LLVM_VERSION_STRING;
+    }();
+    return id;
+}
+
+static std::string
+partKey(const llvm::Module &part)
+{
+    auto optLevel = getOptimizationLevel();
+    std::string ir;
+    llvm::raw_string_ostream out{ir};
+    out << "abc-incremental-1 " << compilerId() << " "
+        << targetMachine->getTargetTriple().str()
+        << " " << targetMachine->getTargetCPU() << " "
+        << targetMachine->getTargetFeatureString() << " O"
+        << optLevel.getSpeedupLevel() << "s" << optLevel.getSizeLevel()
+        << " fp-fusion" << int(targetMachine->Options.AllowFPOpFusion)
+        << " sections" << targetMachine->Options.FunctionSections
+        << targetMachine->Options.DataSections << "\n";
+    part.print(out, nullptr);
+    out.flush();
+    return md5(ir);
+}
+
+// removes the least recently used object files (except 'keep') until the
+// cache is not bigger than 'maxBytes', and temporary files left by
+// interrupted compiler runs
+static void
+evict(const std::filesystem::path &cacheDir, std::uintmax_t maxBytes,
+      const std::vector<std::filesystem::path> &keep)
+{
+    struct Entry
+    {
+	std::filesystem::file_time_type time;
+	std::uintmax_t bytes;
+	std::filesystem::path path;
+    };
+
+    std::error_code ec;
+    std::vector<Entry> entry;
+    std::uintmax_t totalBytes = 0;
+    // a temporary file this old is not written anymore
+    auto staleTime = std::filesystem::file_time_type::clock::now() -
+                     std::chrono::hours{1};
+    for (const auto &file : std::filesystem::directory_iterator{cacheDir, ec}) {
+	if (file.path().extension().string().starts_with(".tmp")) {
+	    if (file.last_write_time(ec) < staleTime && !ec) {
+		std::filesystem::remove(file.path(), ec);
+	    }
+	    continue;
+	} else if (file.path().extension() != ".o") {
+	    continue;
+	}
+	auto bytes = file.file_size(ec);
+	auto time = file.last_write_time(ec);
+	if (ec) {
+	    // removed by a concurrent compiler run
+	    continue;
+	}
+	totalBytes += bytes;
+	entry.push_back(Entry{time, bytes, file.path()});
+    }
+    if (totalBytes <= maxBytes) {
+	return;
+    }
+
+    std::unordered_set<std::string> used;
+    for (const auto &obj : keep) {
+	used.insert(obj.string());
+    }
+    std::sort(entry.begin(), entry.end(),
+              [](const Entry &a, const Entry &b) { return a.time < b.time; });
+    for (const auto &e : entry) {
+	if (totalBytes <= maxBytes) {
+	    break;
+	}
+	if (!used.contains(e.path.string())) {
+	    std::filesystem::remove(e.path, ec);
+	    totalBytes -= e.bytes;
+	}
+    }
+}
+
+std::vector<std::filesystem::path>
+printIncremental(std::filesystem::path cacheDir, std::filesystem::path path,
+                 std::uintmax_t maxBytes, IncrementalStats &stats)
+{
+    assert(llvmContext);
+    assert(targetMachine);
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDir, ec);
+    if (ec) {
+	llvm::errs() << "Could not create cache directory: " << cacheDir
+	             << ". " << ec.message() << "\n";
+	std::exit(1);
+    }
+
+    auto absPath = std::filesystem::absolute(path).string();
+    promoteLocals(*llvmModule, ".abc." + md5(absPath).substr(0, 16));
+
+    std::vector<const llvm::Function *> fn;
+    for (const auto &f : *llvmModule) {
+	if (!f.isDeclaration()) {
+	    fn.push_back(&f);
+	}
+    }
+    fn.push_back(nullptr);
+
+    std::vector<std::filesystem::path> objFile;
+    for (auto f : fn) {
+	auto part = extractPart(*llvmModule, f);
+	auto obj = cacheDir / (partKey(*part) + ".o");
+
+	++stats.numPart;
+	if (std::filesystem::exists(obj)) {
+	    ++stats.numHit;
+	    // the modification time tells evict() when a part was last used
+	    std::filesystem::last_write_time(
+	        obj, std::filesystem::file_time_type::clock::now(), ec);
+	} else {
+	    // write to a temporary file first, the cache can be shared by
+	    // concurrent compiler runs
+	    auto tmp = obj;
+	    tmp += ".tmp" + std::to_string(llvm::sys::Process::getProcessId());
+	    {
+		auto out = llvm::raw_fd_ostream{tmp.c_str(), ec,
+		                                llvm::sys::fs::OF_None};
+		if (ec) {
+		    llvm::errs() << "Could not open file: " << tmp << ". "
+		                 << ec.message() << "\n";
+		    std::exit(1);
+		}
+		optimize(*part);
+		emit(*part, out, OBJECT_FILE);
+	    }
+	    std::filesystem::rename(tmp, obj);
+	}
+	objFile.push_back(obj);
+    }
+    evict(cacheDir, maxBytes, objFile);
+    return objFile;
+}
+
 } // namespace gen
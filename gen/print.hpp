@@ -1,7 +1,10 @@
 #ifndef GEN_PRINT_HPP
 #define GEN_PRINT_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <vector>
 
 namespace gen {
 
@@ -14,6 +17,20 @@ enum FileType
 
 void print(std::filesystem::path path, FileType fileType = LLVM_FILE);
 
+struct IncrementalStats
+{
+	std::size_t numPart = 0;
+	std::size_t numHit = 0;
+};
+
+// Compiles each function definition (and all global variables) into an object
+// file of its own in 'cacheDir' unless it is already there. 'path' is the
+// object file the returned parts are combined into. If the cache gets bigger
+// than 'maxBytes' the least recently used object files are removed.
+std::vector<std::filesystem::path>
+printIncremental(std::filesystem::path cacheDir, std::filesystem::path path,
+                 std::uintmax_t maxBytes, IncrementalStats &stats);
+
 } // namespace gen
 
 #endif // GEN_PRINT_HPP
@@ -0,0 +1,332 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+
+#ifdef SUPPORT_SOLARIS
+// has to be included as first llvm header
+#include "llvm/Support/Solaris/sys/regset.h"
+#endif // SUPPORT_SOLARIS
+
+#include "llvm/IR/InstIterator.h"
+#include "llvm/MC/MCSubtargetInfo.h"
+#include "llvm/Support/Process.h"
+
+#include "util/json.hpp"
+
+#include "gen.hpp"
+#include "stackdepth.hpp"
+
+namespace gen {
+
+static std::filesystem::path frameSizeFile;
+
+void
+recordFrameSizes()
+{
+    assert(targetMachine);
+    frameSizeFile = std::filesystem::temp_directory_path() /
+                    ("abc-stack-" +
+                     std::to_string(llvm::sys::Process::getProcessId()) +
+                     ".su");
+    // the backend appends one line per function
+    std::error_code ec;
+    std::filesystem::remove(frameSizeFile, ec);
+    targetMachine->Options.StackUsageOutput = frameSizeFile.string();
+}
+
+//------------------------------------------------------------------------------
+
+namespace {
+
+struct Frame
+{
+    std::size_t bytes;
+    bool dynamic;
+};
+
+using FrameMap = std::unordered_map<std::string, Frame>;
+
+struct CallGraphWalk
+{
+    const FrameMap &frame;
+    std::size_t returnAddressBytes;
+    std::unordered_map<const llvm::Function *, StackDepth> depth;
+    // functions of the call chain that currently gets walked
+    std::vector<const llvm::Function *> active;
+};
+
+} // namespace
+
+// each line has the form "<source file>:<function>\t<bytes>\t<qualifier>"
+// where the qualifier is "static" or "dynamic"
+static FrameMap
+readFrameSizes()
+{
+    FrameMap frame;
+    std::ifstream in{frameSizeFile};
+    auto prefix = llvmModule->getSourceFileName() + ":";
+    std::string line;
+    while (std::getline(in, line)) {
+	auto tab = line.find('\t');
+	auto tab2 = tab == std::string::npos ? tab : line.find('\t', tab + 1);
+	if (tab2 == std::string::npos) {
+	    continue;
+	}
+	auto name = line.substr(0, tab);
+	if (name.starts_with(prefix)) {
+	    name = name.substr(prefix.size());
+	} else {
+	    name = name.substr(name.rfind(':') + 1);
+	}
+	auto bytes = std::strtoull(line.c_str() + tab + 1, nullptr, 10);
+	frame[name] = Frame{bytes, line.substr(tab2 + 1) == "dynamic"};
+    }
+    std::error_code ec;
+    std::filesystem::remove(frameSizeFile, ec);
+    return frame;
+}
+
+// On AVR a call pushes the program counter, which is not part of the frame
+// size. Other targets are taken to count the return address in the frame.
+static std::size_t
+returnAddressBytes()
+{
+    if (targetMachine->getTargetTriple().getArch() != llvm::Triple::avr) {
+	return 0;
+    }
+    auto sti = targetMachine->getMCSubtargetInfo();
+    return sti && sti->checkFeatures("+eijmpcall") ? 3 : 2;
+}
+
+static bool
+isInterruptHandler(const llvm::Function &fn)
+{
+    switch (fn.getCallingConv()) {
+    case llvm::CallingConv::AVR_INTR:
+    case llvm::CallingConv::AVR_SIGNAL:
+    case llvm::CallingConv::MSP430_INTR:
+    case llvm::CallingConv::X86_INTR:
+	return true;
+    default:
+	// the AVR backend also accepts attributes, and avr-libc names handlers
+	// after their interrupt vector
+	return fn.hasFnAttribute("interrupt") || fn.hasFnAttribute("signal") ||
+	       fn.getName().starts_with("__vector_");
+    }
+}
+
+static void
+setUnbounded(StackDepth &depth, std::string reason)
+{
+    if (depth.bounded) {
+	depth.bounded = false;
+	depth.reason = std::move(reason);
+    }
+}
+
+static const StackDepth &
+computeDepth(CallGraphWalk &walk, const llvm::Function *fn)
+{
+    if (auto found = walk.depth.find(fn); found != walk.depth.end()) {
+	return found->second;
+    }
+
+    StackDepth depth;
+    depth.function = fn->getName().str();
+    if (auto frame = walk.frame.find(depth.function);
+        frame != walk.frame.end()) {
+	depth.frameBytes = frame->second.bytes;
+	if (frame->second.dynamic) {
+	    setUnbounded(depth, "frame of '" + depth.function +
+	                            "' has a dynamic size");
+	}
+    } else {
+	setUnbounded(depth, "no frame size for '" + depth.function + "'");
+    }
+
+    std::size_t calleeBytes = 0;
+    const std::vector<std::string> *calleePath = nullptr;
+    walk.active.push_back(fn);
+    for (const auto &inst : llvm::instructions(fn)) {
+	auto call = llvm::dyn_cast<llvm::CallBase>(&inst);
+	if (!call || call->isInlineAsm()) {
+	    continue;
+	}
+	auto callee = call->getCalledFunction();
+	if (!callee) {
+	    setUnbounded(depth, "indirect call in '" + depth.function + "'");
+	    continue;
+	}
+	// intrinsics are either expanded inline or become calls of small
+	// runtime functions (e.g. memcpy) that are not counted
+	if (callee->isIntrinsic()) {
+	    continue;
+	}
+	if (callee->isDeclaration()) {
+	    setUnbounded(depth, "'" + depth.function + "' calls '" +
+	                            callee->getName().str() +
+	                            "', which is defined elsewhere");
+	    continue;
+	}
+	auto active = std::find(walk.active.begin(), walk.active.end(), callee);
+	if (active != walk.active.end()) {
+	    std::string cycle;
+	    for (; active != walk.active.end(); ++active) {
+		cycle += (*active)->getName().str() + " -> ";
+	    }
+	    setUnbounded(depth, "recursion " + cycle + callee->getName().str());
+	    continue;
+	}
+
+	// the depth of a callee stays where it is when more get added
+	const auto &calleeDepth = computeDepth(walk, callee);
+	if (!calleeDepth.bounded) {
+	    setUnbounded(depth, calleeDepth.reason);
+	}
+	auto bytes = walk.returnAddressBytes + calleeDepth.depthBytes;
+	if (!calleePath || bytes > calleeBytes) {
+	    calleeBytes = bytes;
+	    calleePath = &calleeDepth.path;
+	}
+    }
+    walk.active.pop_back();
+
+    depth.depthBytes = depth.frameBytes + calleeBytes;
+    depth.path.push_back(depth.function);
+    if (calleePath) {
+	depth.path.insert(depth.path.end(), calleePath->begin(),
+	                  calleePath->end());
+    }
+    return walk.depth.emplace(fn, std::move(depth)).first->second;
+}
+
+StackReport
+analyzeStackDepth()
+{
+    assert(llvmModule);
+    assert(targetMachine);
+    targetMachine->Options.StackUsageOutput.clear();
+
+    StackReport report;
+    report.returnAddressBytes = returnAddressBytes();
+    auto frame = readFrameSizes();
+    CallGraphWalk walk{frame, report.returnAddressBytes, {}, {}};
+
+    std::size_t mainBytes = 0;
+    std::size_t handlerBytes = 0;
+    bool hasHandler = false;
+    for (const auto &fn : *llvmModule) {
+	if (fn.isDeclaration()) {
+	    continue;
+	}
+	const auto &depth = computeDepth(walk, &fn);
+	report.function.push_back(depth);
+	if (fn.getName() == "main") {
+	    mainBytes = depth.depthBytes;
+	} else if (isInterruptHandler(fn)) {
+	    hasHandler = true;
+	    handlerBytes = std::max(handlerBytes, depth.depthBytes);
+	} else {
+	    continue;
+	}
+	report.root.push_back(depth);
+	report.bounded = report.bounded && depth.bounded;
+    }
+    // without a root there is no worst case to bound
+    if (report.root.empty()) {
+	report.bounded = false;
+    }
+    // an interrupt pushes the program counter like a call
+    report.worstCaseBytes =
+        mainBytes + (hasHandler ? report.returnAddressBytes + handlerBytes : 0);
+    return report;
+}
+
+//------------------------------------------------------------------------------
+
+static void
+printDepth(std::ostream &out, const StackDepth &depth)
+{
+    out << "stack-report: " << depth.function << ": ";
+    if (!depth.bounded) {
+	out << "unbounded (" << depth.reason << "), at least ";
+    }
+    out << depth.depthBytes << " bytes:";
+    for (std::size_t i = 0; i < depth.path.size(); ++i) {
+	out << (i ? " -> " : " ") << depth.path[i];
+    }
+    out << "\n";
+}
+
+void
+printStackReport(std::ostream &out, const StackReport &report)
+{
+    // without 'main' or an interrupt handler every function is a root
+    const auto &root = report.root.empty() ? report.function : report.root;
+    for (const auto &depth : root) {
+	printDepth(out, depth);
+    }
+    if (!report.root.empty()) {
+	out << "stack-report: worst case: "
+	    << (report.bounded ? "" : "unbounded, at least ")
+	    << report.worstCaseBytes << " bytes\n";
+    }
+}
+
+static void
+printDepthJson(std::ostream &out, const StackDepth &depth)
+{
+    out << "{\"function\": ";
+    abc::printJsonString(out, depth.function);
+    out << ", "
+        << "\"frame_bytes\": " << depth.frameBytes << ", "
+        << "\"depth_bytes\": " << depth.depthBytes << ", "
+        << "\"bounded\": " << (depth.bounded ? "true" : "false") << ", "
+        << "\"reason\": ";
+    abc::printJsonString(out, depth.reason);
+    out << ", "
+        << "\"path\": [";
+    for (std::size_t i = 0; i < depth.path.size(); ++i) {
+	out << (i ? ", " : "");
+	abc::printJsonString(out, depth.path[i]);
+    }
+    out << "]}";
+}
+
+static void
+printDepthListJson(std::ostream &out, const std::vector<StackDepth> &list,
+                   int indent)
+{
+    out << "[";
+    for (std::size_t i = 0; i < list.size(); ++i) {
+	out << (i ? ",\n" : "\n") << std::setw(indent + 2) << "";
+	printDepthJson(out, list[i]);
+    }
+    if (!list.empty()) {
+	out << "\n" << std::setw(indent) << "";
+    }
+    out << "]";
+}
+
+void
+printStackReportJson(std::ostream &out, const StackReport &report, int indent)
+{
+    out << std::setw(indent) << "" << "\"return_address_bytes\": "
+        << report.returnAddressBytes << ",\n";
+    out << std::setw(indent) << "" << "\"worst_case_bytes\": "
+        << report.worstCaseBytes << ",\n";
+    out << std::setw(indent) << "" << "\"bounded\": "
+        << (report.bounded ? "true" : "false") << ",\n";
+    out << std::setw(indent) << "" << "\"roots\": ";
+    printDepthListJson(out, report.root, indent);
+    out << ",\n" << std::setw(indent) << "" << "\"functions\": ";
+    printDepthListJson(out, report.function, indent);
+}
+
+} // namespace gen
@@ -0,0 +1,63 @@
+#ifndef GEN_STACKDEPTH_HPP
+#define GEN_STACKDEPTH_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//
+// Static worst-case stack depth (-fstack-report). The backend writes the frame
+// size of each function it compiles to a file (like -fstack-usage of gcc and
+// clang). Combined with the direct calls of the compiled module this gives the
+// deepest call chain from 'main' and from each interrupt handler. Recursion,
+// indirect calls, calls to functions defined elsewhere and frames of dynamic
+// size make a depth unbounded.
+//
+
+namespace gen {
+
+struct StackDepth
+{
+	std::string function;
+	std::size_t frameBytes = 0;
+	// frame of this function and its deepest call chain, return addresses
+	// included; a lower bound if not bounded
+	std::size_t depthBytes = 0;
+	bool bounded = true;
+	// why the depth is not bounded
+	std::string reason;
+	// deepest call chain, starting with this function
+	std::vector<std::string> path;
+};
+
+struct StackReport
+{
+	std::size_t returnAddressBytes = 0;
+	// 'main' (if defined) and interrupt handlers
+	std::vector<StackDepth> root;
+	// all function definitions
+	std::vector<StackDepth> function;
+
+	// depth of 'main' plus the deepest interrupt handler (interrupts are
+	// assumed not to nest); not bounded if there is no root
+	std::size_t worstCaseBytes = 0;
+	bool bounded = true;
+};
+
+// Has the backend record the frame size of each function when the module gets
+// compiled by the next print(). Has to be called after init().
+void recordFrameSizes();
+
+// Analyzes the module compiled by print() with the recorded frame sizes
+StackReport analyzeStackDepth();
+
+void printStackReport(std::ostream &out, const StackReport &report);
+
+// print report as members of a JSON object
+void printStackReportJson(std::ostream &out, const StackReport &report,
+                          int indent = 0);
+
+} // namespace gen
+
+#endif // GEN_STACKDEPTH_HPP
@@ -9,6 +9,7 @@
 #endif // SUPPORT_SOLARIS
 
 #include "llvm/Analysis/ConstantFolding.h"
+#include "llvm/TargetParser/Triple.h"
 
 #include "type/integertype.hpp"
 
@@ -16,6 +17,7 @@
 #include "function.hpp"
 #include "gentype.hpp"
 #include "instruction.hpp"
+#include "label.hpp"
 #include "variable.hpp"
 
 namespace gen {
@@ -25,6 +27,9 @@ static std::unordered_map<std::string, std::string> stringMap;
 
 // Map with all local variables
 static std::unordered_map<const char *, llvm::AllocaInst *> localVariable;
+
+// Map with all local names that refer to memory owned by the caller
+static std::unordered_map<const char *, Value> localReference;
 static Value lookup(const char *ident);
 
 //------------------------------------------------------------------------------
@@ -84,6 +89,34 @@ globalVariableDefinition(const char *ident, const abc::Type *varType,
                              /*Name=*/ident, nullptr);
 }
 
+Constant
+constantVariableDefinition(const char *ident, const abc::Type *varType,
+                           Constant value, bool externalLinkage)
+{
+    assert(llvmModule);
+    assert(!varType->isFunction());
+
+    if (auto var = llvmModule->getGlobalVariable(ident, true)) {
+	return var;
+    }
+
+    auto llvmVarType = convert(varType);
+    assert(llvmVarType);
+
+    auto linkage = externalLinkage ? llvm::GlobalValue::LinkOnceODRLinkage
+                                   : llvm::GlobalValue::InternalLinkage;
+    auto var = new llvm::GlobalVariable(*llvmModule, llvmVarType,
+                                        /*isConstant=*/true,
+                                        /*Linkage=*/linkage,
+                                        /*Initializer=*/value,
+                                        /*Name=*/ident, nullptr);
+    if (externalLinkage &&
+        llvm::Triple(llvmModule->getTargetTriple()).supportsCOMDAT()) {
+	var->setComdat(llvmModule->getOrInsertComdat(ident));
+    }
+    return var;
+}
+
 Constant
 loadStringAddress(const char *stringLiteral)
 {
@@ -128,6 +161,13 @@ localVariableDefinition(const char *ident, const abc::Type *varType)
     return localVariable[ident];
 }
 
+void
+localReferenceDefinition(const char *ident, Value addr)
+{
+    assert(functionBuildingInfo.fn);
+    localReference[ident] = addr;
+}
+
 void
 forgetAllVariables()
 {
@@ -139,6 +179,7 @@ void
 forgetAllLocalVariables()
 {
     localVariable.clear();
+    localReference.clear();
 }
 
 static Value
@@ -151,6 +192,8 @@ lookup(const char *ident)
 	return fn;
     } else if (localVariable.contains(ident)) {
 	return localVariable.at(ident);
+    } else if (localReference.contains(ident)) {
+	return localReference.at(ident);
     } else {
 	return nullptr;
     }
@@ -199,7 +242,8 @@ pointerIncrement(const abc::Type *type, Constant pointer, std::uint64_t offset)
 }
 
 Value
-pointerIncrement(const abc::Type *type, Value pointer, Value offset)
+pointerIncrement(const abc::Type *type, Value pointer, Value offset,
+                 bool inbounds)
 {
     assert(llvmBuilder);
     assert(type);
@@ -209,6 +253,9 @@ pointerIncrement(const abc::Type *type, Value pointer, Value offset)
     std::vector<Value> idxList{1};
     idxList[0] = offset;
 
+    if (inbounds) {
+	return llvmBuilder->CreateInBoundsGEP(llvmType, pointer, idxList);
+    }
     return llvmBuilder->CreateGEP(llvmType, pointer, idxList);
 }
 
@@ -254,6 +301,202 @@ pointerToIndex(const abc::Type *type, Value pointer, std::size_t index)
     return llvmBuilder->CreateGEP(llvmType, pointer, idxList);
 }
 
+Value
+soaMemberAddress(const abc::Type *type, Value soa, std::size_t memberIndex,
+                 Value index)
+{
+    assert(llvmBuilder);
+    assert(type);
+    assert(type->isSoaArray());
+    assert(functionBuildingInfo.fn);
+    reachableCheck();
+    auto llvmType = convert(type);
+
+    std::vector<Value> idxList{3};
+    idxList[0] = getConstantZero(abc::IntegerType::createSigned(8));
+    idxList[1] =
+        getConstantInt(memberIndex, abc::IntegerType::createUnsigned(32));
+    idxList[2] = index;
+
+    return llvmBuilder->CreateInBoundsGEP(llvmType, soa, idxList);
+}
+
+Value
+soaFetch(const abc::Type *type, Value soa, Value index)
+{
+    assert(llvmBuilder);
+    assert(type);
+    assert(type->isSoaArray());
+    assert(functionBuildingInfo.fn);
+    reachableCheck();
+    auto llvmStructType = convert(type->refType());
+
+    // gather the element from the member arrays
+    Value val = llvm::PoisonValue::get(llvmStructType);
+    for (unsigned i = 0; i < llvmStructType->getStructNumElements(); ++i) {
+	auto addr = soaMemberAddress(type, soa, i, index);
+	auto member = llvmBuilder->CreateLoad(
+	    llvmStructType->getStructElementType(i), addr);
+	val = llvmBuilder->CreateInsertValue(val, member, i);
+    }
+    return val;
+}
+
+// bits [offset, offset + width) of 'val', sign or zero extended
+static Value
+extractBits(Value val, const abc::Type *type, std::size_t offset,
+            std::size_t width)
+{
+    auto bits = type->numBits();
+    if (type->isSignedInteger()) {
+	auto shl = llvmBuilder->CreateShl(val, bits - offset - width);
+	return llvmBuilder->CreateAShr(shl, bits - width);
+    }
+    auto mask = llvm::APInt::getLowBitsSet(bits, width);
+    return llvmBuilder->CreateAnd(llvmBuilder->CreateLShr(val, offset),
+                                  llvm::ConstantInt::get(convert(type), mask));
+}
+
+Value
+bitFieldFetch(Value addr, const abc::Type *type, std::size_t offset,
+              std::size_t width)
+{
+    assert(llvmBuilder);
+    assert(type->isInteger());
+    assert(offset + width <= type->numBits());
+    assert(functionBuildingInfo.fn);
+    reachableCheck();
+
+    auto unit = llvmBuilder->CreateLoad(convert(type), addr);
+    return extractBits(unit, type, offset, width);
+}
+
+Value
+bitFieldStore(Value val, Value addr, const abc::Type *type, std::size_t offset,
+              std::size_t width)
+{
+    assert(llvmBuilder);
+    assert(type->isInteger());
+    assert(offset + width <= type->numBits());
+    assert(functionBuildingInfo.fn);
+    reachableCheck();
+
+    auto llvmType = convert(type);
+    auto bits = type->numBits();
+    auto fieldMask = llvm::APInt::getBitsSet(bits, offset, offset + width);
+    auto lowMask = llvm::APInt::getLowBitsSet(bits, width);
+
+    auto unit = llvmBuilder->CreateLoad(llvmType, addr);
+    auto cleared = llvmBuilder->CreateAnd(
+        unit, llvm::ConstantInt::get(llvmType, ~fieldMask));
+    auto field = llvmBuilder->CreateShl(
+        llvmBuilder->CreateAnd(val, llvm::ConstantInt::get(llvmType, lowMask)),
+        offset);
+    llvmBuilder->CreateStore(llvmBuilder->CreateOr(cleared, field), addr);
+    return extractBits(val, type, 0, width);
+}
+
+// address of the word that contains bit 'index' and the mask for the bit
+static std::pair<Value, Value>
+packedBoolBit(Value addr, Value index)
+{
+    auto wordType = abc::IntegerType::createSizeType();
+    auto llvmWordType = convert(wordType);
+    auto bits = wordType->numBits();
+
+    auto wordIndex = llvmBuilder->CreateLShr(index, llvm::Log2_64(bits));
+    auto bit = llvmBuilder->CreateAnd(index, bits - 1);
+    auto wordAddr = llvmBuilder->CreateInBoundsGEP(
+        llvmWordType, addr, std::vector<Value>{wordIndex});
+    auto mask = llvmBuilder->CreateShl(llvm::ConstantInt::get(llvmWordType, 1),
+                                       bit);
+    return {wordAddr, mask};
+}
+
+Value
+packedBoolFetch(const abc::Type *type, Value addr, Value index)
+{
+    assert(llvmBuilder);
+    assert(type->isPackedBoolArray());
+    assert(functionBuildingInfo.fn);
+    reachableCheck();
+
+    auto [wordAddr, mask] = packedBoolBit(addr, index);
+    auto llvmWordType = convert(abc::IntegerType::createSizeType());
+    auto word = llvmBuilder->CreateLoad(llvmWordType, wordAddr);
+    return llvmBuilder->CreateICmpNE(llvmBuilder->CreateAnd(word, mask),
+                                     llvm::ConstantInt::get(llvmWordType, 0));
+}
+
+Value
+packedBoolStore(Value val, const abc::Type *type, Value addr, Value index)
+{
+    assert(llvmBuilder);
+    assert(type->isPackedBoolArray());
+    assert(functionBuildingInfo.fn);
+    reachableCheck();
+
+    auto [wordAddr, mask] = packedBoolBit(addr, index);
+    auto llvmWordType = convert(abc::IntegerType::createSizeType());
+    auto word = llvmBuilder->CreateLoad(llvmWordType, wordAddr);
+    auto set = llvmBuilder->CreateOr(word, mask);
+    auto cleared = llvmBuilder->CreateAnd(word, llvmBuilder->CreateNot(mask));
+    auto newWord = llvmBuilder->CreateSelect(val, set, cleared);
+    llvmBuilder->CreateStore(newWord, wordAddr);
+    return val;
+}
+
+// number of set bits: a loop that adds the popcount of each word. The unused
+// bits of the last word are masked off.
+Value
+packedBoolCount(const abc::Type *type, Value addr)
+{
+    assert(llvmBuilder);
+    assert(type->isPackedBoolArray());
+    assert(functionBuildingInfo.fn);
+    reachableCheck();
+
+    auto wordType = abc::IntegerType::createSizeType();
+    auto llvmWordType = convert(wordType);
+    auto numWords =
+        llvm::cast<llvm::ArrayType>(convert(type))->getNumElements();
+    auto zero = llvm::ConstantInt::get(llvmWordType, 0);
+    auto wordBits = llvmWordType->getIntegerBitWidth();
+    auto lastMask = llvm::APInt::getLowBitsSet(
+        wordBits, type->dim() % wordBits ? type->dim() % wordBits : wordBits);
+
+    auto preLabel = llvmBuilder->GetInsertBlock();
+    auto loopLabel = getLabel("popcount");
+    auto endLabel = getLabel("popcount.end");
+    jumpInstruction(loopLabel);
+
+    defineLabel(loopLabel);
+    auto i = llvmBuilder->CreatePHI(llvmWordType, 2);
+    auto sum = llvmBuilder->CreatePHI(llvmWordType, 2);
+    auto next =
+        llvmBuilder->CreateAdd(i, llvm::ConstantInt::get(llvmWordType, 1));
+    auto more = llvmBuilder->CreateICmpULT(
+        next, llvm::ConstantInt::get(llvmWordType, numWords));
+    auto wordAddr = llvmBuilder->CreateInBoundsGEP(llvmWordType, addr,
+                                                   std::vector<Value>{i});
+    auto word = llvmBuilder->CreateAnd(
+        llvmBuilder->CreateLoad(llvmWordType, wordAddr),
+        llvmBuilder->CreateSelect(
+            more, llvm::Constant::getAllOnesValue(llvmWordType),
+            llvm::ConstantInt::get(llvmWordType, lastMask)));
+    auto newSum = llvmBuilder->CreateAdd(
+        sum, llvmBuilder->CreateUnaryIntrinsic(llvm::Intrinsic::ctpop, word));
+    auto loopEnd = llvmBuilder->GetInsertBlock();
+    jumpInstruction(more, loopLabel, endLabel);
+    i->addIncoming(zero, preLabel);
+    i->addIncoming(next, loopEnd);
+    sum->addIncoming(zero, preLabel);
+    sum->addIncoming(newSum, loopEnd);
+
+    defineLabel(endLabel);
+    return newSum;
+}
+
 Value
 fetch(Value addr, const abc::Type *type)
 {
@@ -12,9 +12,18 @@ bool externalVariableDeclaration(const char *ident, const abc::Type *varType);
 void globalVariableDefinition(const char *ident, const abc::Type *varType,
                               Constant initialValue = nullptr);
 
+// for global constants that are folded where they are used: the variable is
+// only defined if its address is needed. With external linkage it gets
+// 'linkonce_odr' linkage so that all translation units can share one
+// definition, otherwise it stays local to this translation unit.
+Constant constantVariableDefinition(const char *ident,
+                                    const abc::Type *varType, Constant value,
+                                    bool externalLinkage);
+
 Constant loadStringAddress(const char *str);
 
 Value localVariableDefinition(const char *ident, const abc::Type *varType);
+void localReferenceDefinition(const char *ident, Value addr);
 
 void forgetAllVariables();
 void forgetAllLocalVariables();
@@ -25,7 +34,8 @@ Value loadAddress(const char *ident);
 
 Constant pointerIncrement(const abc::Type *type, Constant pointer,
                           std::uint64_t offset);
-Value pointerIncrement(const abc::Type *type, Value pointer, Value offset);
+Value pointerIncrement(const abc::Type *type, Value pointer, Value offset,
+                       bool inbounds = false);
 
 std::optional<Constant> pointerConstantDifference(const abc::Type *type,
                                                   Value pointer1,
@@ -33,6 +43,25 @@ std::optional<Constant> pointerConstantDifference(const abc::Type *type,
 Value pointerDifference(const abc::Type *type, Value pointer1, Value pointer2);
 Value pointerToIndex(const abc::Type *type, Value pointer, std::size_t index);
 
+// for 'soa array' types: address of member 'memberIndex' of element 'index'
+// and the value of element 'index'
+Value soaMemberAddress(const abc::Type *type, Value soa,
+                       std::size_t memberIndex, Value index);
+Value soaFetch(const abc::Type *type, Value soa, Value index);
+
+// for bit-fields of integer 'type': 'addr' is the address of the storage
+// unit. The store returns the value the bit-field has afterwards.
+Value bitFieldFetch(Value addr, const abc::Type *type, std::size_t offset,
+                    std::size_t width);
+Value bitFieldStore(Value val, Value addr, const abc::Type *type,
+                    std::size_t offset, std::size_t width);
+
+// for 'packed array' types: 'addr' is the address of the array
+Value packedBoolFetch(const abc::Type *type, Value addr, Value index);
+Value packedBoolStore(Value val, const abc::Type *type, Value addr,
+                      Value index);
+Value packedBoolCount(const abc::Type *type, Value addr);
+
 Value fetch(Value addr, const abc::Type *type);
 Value store(Value val, Value addr);
 
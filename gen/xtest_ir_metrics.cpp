@@ -0,0 +1,76 @@
+#include <cstdlib>
+#include <iostream>
+
+#ifdef SUPPORT_SOLARIS
+// has to be included as first llvm header
+#include "llvm/Support/Solaris/sys/regset.h"
+#endif // SUPPORT_SOLARIS
+
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+
+//
+// Prints IR metrics for each function defined in the given LLVM IR files:
+//
+//   file function insts bbs allocas loads stores alloca_bytes
+//
+// where 'alloca_bytes' is the total size of all static allocas. This is not
+// the frame size chosen by the backend (see -fstack-report for that).
+//
+
+void
+usage(const char *prog)
+{
+    std::cerr << "usage: " << prog << " file.ll..." << std::endl;
+    std::exit(1);
+}
+
+int
+main(int argc, char *argv[])
+{
+    if (argc < 2) {
+	usage(argv[0]);
+    }
+
+    llvm::LLVMContext context;
+    for (int i = 1; i < argc; ++i) {
+	llvm::SMDiagnostic err;
+	auto module = llvm::parseIRFile(argv[i], err, context);
+	if (!module) {
+	    err.print(argv[0], llvm::errs());
+	    return 1;
+	}
+	const auto &dataLayout = module->getDataLayout();
+
+	for (const auto &fn : *module) {
+	    if (fn.isDeclaration()) {
+		continue;
+	    }
+	    std::size_t insts = 0, bbs = 0, allocas = 0, loads = 0,
+	                stores = 0, allocaBytes = 0;
+	    for (const auto &bb : fn) {
+		++bbs;
+		for (const auto &inst : bb) {
+		    ++insts;
+		    if (auto alloca = llvm::dyn_cast<llvm::AllocaInst>(&inst)) {
+			++allocas;
+			if (auto size = alloca->getAllocationSize(dataLayout)) {
+			    allocaBytes += size->getFixedValue();
+			}
+		    } else if (llvm::isa<llvm::LoadInst>(inst)) {
+			++loads;
+		    } else if (llvm::isa<llvm::StoreInst>(inst)) {
+			++stores;
+		    }
+		}
+	    }
+	    std::cout << argv[i] << " " << fn.getName().str() << " " << insts
+	              << " " << bbs << " " << allocas << " " << loads << " "
+	              << stores << " " << allocaBytes << "\n";
+	}
+    }
+}
@@ -0,0 +1,74 @@
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include "util/bench.hpp"
+
+#include "lexer.hpp"
+#include "reader.hpp"
+
+// some ABC source with identifiers, keywords, literals, operators, comments
+static std::string
+randomSource(std::mt19937_64 &rng, std::size_t numFn)
+{
+    std::uniform_int_distribution<int> val(0, 9999);
+    std::ostringstream out;
+
+    out << "@define N 42\n";
+    for (std::size_t i = 0; i < numFn; ++i) {
+	out << "// function " << i << "\n"
+	    << "fn foo" << i << "(a: int, b: -> char, c: double): int\n"
+	    << "{\n"
+	    << "    local x: int = a * " << val(rng) << " + b[" << val(rng)
+	    << "] - N;\n"
+	    << "    local y: array[8] of u8 = {1, 2, 0x" << std::hex
+	    << val(rng) << std::dec << ", 3};\n"
+	    << "    for (local i: int = 0; i < x; ++i) {\n"
+	    << "        x += i << 2; /* shift */\n"
+	    << "        c = c * " << val(rng) << ".5e-3;\n"
+	    << "    }\n"
+	    << "    if (x >= 0 && x != 17) {\n"
+	    << "        printf(\"x = %d\\n\", x);\n"
+	    << "    }\n"
+	    << "    return x > 0 ? x : -x;\n"
+	    << "}\n\n";
+    }
+    return out.str();
+}
+
+static void
+openSource(const std::filesystem::path &path)
+{
+    abc::lexer::reader.reset();
+    abc::lexer::init();
+    abc::lexer::openInputfile(path);
+}
+
+int
+main(int argc, char *argv[])
+{
+    using namespace abc;
+
+    bench::init(argc, argv);
+    std::mt19937_64 rng{bench::config.seed};
+
+    auto path = std::filesystem::temp_directory_path() / "bench_lexer.abc";
+    std::ofstream(path) << randomSource(rng, 500);
+
+    std::size_t numTokens = 0;
+    openSource(path);
+    while (lexer::getToken() != lexer::TokenKind::EOI) {
+	++numTokens;
+    }
+
+    bench::run(
+        "lexer::getToken", numTokens, [&] { openSource(path); },
+        [] {
+	    while (lexer::getToken() != lexer::TokenKind::EOI) {
+	    }
+        });
+
+    std::filesystem::remove(path);
+    bench::report("lexer");
+}
@@ -2,7 +2,9 @@
 #include <iostream>
 #include <optional>
 #include <string>
+#include <vector>
 
+#include "util/stats.hpp"
 #include "util/ustr.hpp"
 
 #include "error.hpp"
@@ -17,6 +19,7 @@ Token token, lastToken;
 
 static std::unordered_map<UStr, TokenKind> keyword;
 static std::set<std::filesystem::path> includedFiles_;
+static std::vector<Token> pushedBack;
 
 static bool isWhiteSpace(int ch);
 static bool isDecDigit(int ch);
@@ -71,6 +74,8 @@ init()
 {
     macro::init();
     includedFiles_.clear();
+    pushedBack.clear();
+    keyword.clear();
     keyword[UStr::create("array")] = TokenKind::ARRAY;
     keyword[UStr::create("assert")] = TokenKind::ASSERT;
     keyword[UStr::create("break")] = TokenKind::BREAK;
@@ -127,6 +132,11 @@ TokenKind
 getToken()
 {
     lastToken = token;
+    if (!pushedBack.empty()) {
+	token = pushedBack.back();
+	pushedBack.pop_back();
+	return token.kind;
+    }
     do {
 	while (true) {
 	    if (macro::hasToken()) {
@@ -146,9 +156,17 @@ getToken()
 	    token = Token(token.loc, keyword.at(token.val), token.val);
 	}
     } while (macro::ignoreToken());
+    stats::count(stats::TOKENS);
     return token.kind;
 }
 
+void
+ungetToken(Token tok)
+{
+    pushedBack.push_back(token);
+    token = tok;
+}
+
 TokenKind
 getToken_(bool skipNewline)
 {
@@ -769,6 +787,7 @@ parseAddDirective()
 	    error::fatal();
 	}
 	includedFiles_.insert(token.processedVal.c_str());
+	stats::count(stats::INCLUDES);
     } else if (token.kind == TokenKind::LESS) {
 	std::string str;
 	while (reader->ch != '>') {
@@ -791,6 +810,7 @@ parseAddDirective()
 	                 << std::endl;
 	    error::fatal();
 	}
+	stats::count(stats::INCLUDES);
     } else {
 	error::out() << token.loc << ": expected directive or filename"
 	             << std::endl;
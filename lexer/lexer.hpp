@@ -17,6 +17,10 @@ extern Token token, lastToken;
 
 TokenKind getToken();
 
+// make 'tok' the current token again, the current token becomes the next one
+// returned by getToken()
+void ungetToken(Token tok);
+
 } // namespace lexer
 } // namespace abc
 
@@ -2,6 +2,8 @@
 #include <unordered_set>
 #include <vector>
 
+#include "util/stats.hpp"
+
 #include "macro.hpp"
 
 template <> struct std::hash<abc::lexer::Token>
@@ -26,6 +28,7 @@ void
 init()
 {
     define.clear();
+    token.clear();
     insideIfdef = ignoreToken_ = false;
 }
 
@@ -97,6 +100,7 @@ expandMacro(Token identifier)
     }
 
     expandMacro_(identifier);
+    stats::count(stats::MACRO_EXPANSIONS);
     return true;
 }
 
@@ -104,6 +104,13 @@ openInputfile(std::filesystem::path path)
     }
 }
 
+void
+closeInputfiles()
+{
+    reader.reset();
+    openReader.clear();
+}
+
 void
 addSearchPath(std::filesystem::path path)
 {
@@ -36,6 +36,8 @@ std::filesystem::path searchFile(std::filesystem::path path);
 
 // if path is empty read from stdin
 bool openInputfile(std::filesystem::path path);
+// close the current and all suspended input files
+void closeInputfiles();
 void addSearchPath(std::filesystem::path path);
 const std::vector<std::filesystem::path> &getSearchPath();
 
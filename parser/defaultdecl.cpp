@@ -1,13 +1,44 @@
 #include "expr/assertexpr.hpp"
+#include "expr/callexpr.hpp"
 #include "gen/function.hpp"
 #include "type/functiontype.hpp"
 #include "type/integertype.hpp"
 #include "type/pointertype.hpp"
+#include "type/voidtype.hpp"
 
 #include "defaultdecl.hpp"
 
 namespace abc {
 
+// wrappers of malloc and free in abc-lib/heapprofile.abc, see heapprofile.hdr
+static void
+initHeapProfileDecl()
+{
+    auto file = PointerType::create(IntegerType::createChar()->getConst());
+    auto voidPtr = PointerType::create(VoidType::create());
+
+    std::vector<const Type *> mallocParam;
+    mallocParam.push_back(IntegerType::createSizeType());
+    mallocParam.push_back(file);
+    mallocParam.push_back(IntegerType::createInt());
+    auto mallocType = FunctionType::create(voidPtr, std::move(mallocParam));
+
+    std::vector<const Type *> freeParam;
+    freeParam.push_back(voidPtr);
+    freeParam.push_back(file);
+    freeParam.push_back(IntegerType::createInt());
+    auto freeType = FunctionType::create(VoidType::create(),
+                                         std::move(freeParam));
+
+    auto mallocName = UStr::create("__abc_heap_malloc");
+    auto freeName = UStr::create("__abc_heap_free");
+    CallExpr::setHeapProfileFunctions(mallocName, mallocType, freeName,
+                                      freeType);
+
+    gen::functionDeclaration(mallocName.c_str(), mallocType, true);
+    gen::functionDeclaration(freeName.c_str(), freeType, true);
+}
+
 void
 initDefaultDecl()
 {
@@ -23,6 +54,10 @@ initDefaultDecl()
     AssertExpr::setFunction(assertName, assertType);
 
     gen::functionDeclaration(assertName.c_str(), assertType, true);
+
+    if (CallExpr::heapProfileEnabled()) {
+	initHeapProfileDecl();
+    }
 }
 
 } // namespace abc
@@ -31,7 +31,7 @@ initDefaultType()
     Symtab::addType(lexer::Loc{}, UStr::create("size_t"),
                     IntegerType::createSizeType()->getAlias("size_t"));
     Symtab::addType(lexer::Loc{}, UStr::create("ptrdiff_t"),
-                    IntegerType::createSizeType()->getAlias("ptrdiff_t"));
+                    IntegerType::createPtrdiffType()->getAlias("ptrdiff_t"));
 
     Symtab::addType(lexer::Loc{}, UStr::create("i8"),
                     IntegerType::createSigned(8));
@@ -1,4 +1,5 @@
 #include "expr/assertexpr.hpp"
+#include "expr/bitcount.hpp"
 #include "expr/binaryexpr.hpp"
 #include "expr/callexpr.hpp"
 #include "expr/characterliteral.hpp"
@@ -10,6 +11,7 @@
 #include "expr/floatliteral.hpp"
 #include "expr/identifier.hpp"
 #include "expr/integerliteral.hpp"
+#include "expr/labeladdress.hpp"
 #include "expr/member.hpp"
 #include "expr/nullptr.hpp"
 #include "expr/sizeof.hpp"
@@ -64,6 +66,20 @@ parseCompoundExpression(const Type *type)
 	    error::fatal();
 	}
     } else if (token.kind == TokenKind::LBRACE) {
+	if (type->hasBitFields() || type->isPackedBoolArray() ||
+	    type->isSoaArray()) {
+	    // positions in a compound would refer to storage units, not to
+	    // members or elements
+	    error::location(tok.loc);
+	    error::out() << error::setColor(error::BOLD) << tok.loc << ": "
+	                 << error::setColor(error::BOLD_RED)
+	                 << "error: " << error::setColor(error::BOLD)
+	                 << "no compound expression for type '" << type
+	                 << "'\n"
+	                 << error::setColor(error::NORMAL);
+	    error::fatal();
+	    return nullptr;
+	}
 	getToken();
 	std::size_t maxIndex = 0;
 	for (std::size_t i = 0;; ++i) {
@@ -476,6 +492,15 @@ parsePrefix()
     case TokenKind::AND:
 	getToken();
 	return UnaryExpr::create(UnaryExpr::ADDRESS, parsePrefix(), tok.loc);
+    case TokenKind::AND2:
+	// address of a label
+	getToken();
+	if (!error::expected(TokenKind::IDENTIFIER)) {
+	    return nullptr;
+	}
+	tok = token;
+	getToken();
+	return LabelAddress::create(tok.val, tok.loc);
     case TokenKind::ASTERISK:
 	getToken();
 	return UnaryExpr::create(UnaryExpr::ASTERISK_DEREF, parsePrefix(),
@@ -605,13 +630,45 @@ parseSuffixType()
     return type;
 }
 
+// 'bitcount' is only a keyword if it is followed by '(' and not declared
+static ExprPtr
+parseBitCount(lexer::Token tok)
+{
+    if (tok.val != UStr::create("bitcount") ||
+        token.kind != TokenKind::LPAREN ||
+        Symtab::type(tok.val, Symtab::AnyScope) ||
+        Symtab::constant(tok.val, Symtab::AnyScope) ||
+        Symtab::variable(tok.val, Symtab::AnyScope)) {
+	return nullptr;
+    }
+    getToken();
+    auto expr = parseAssignmentExpression();
+    if (!expr) {
+	error::location(token.loc);
+	error::out() << error::setColor(error::BOLD) << token.loc << ": "
+	             << error::setColor(error::BOLD_RED)
+	             << "error: " << error::setColor(error::BOLD)
+	             << "expected expression\n"
+	             << error::setColor(error::NORMAL);
+	error::fatal();
+	return nullptr;
+    }
+    if (!error::expected(TokenKind::RPAREN)) {
+	return nullptr;
+    }
+    getToken();
+    return BitCount::create(std::move(expr), tok.loc);
+}
+
 static ExprPtr
 parsePrimary()
 {
     auto tok = token;
     if (tok.kind == TokenKind::IDENTIFIER) {
 	getToken();
-	if (auto sym = Symtab::type(tok.val, Symtab::AnyScope)) {
+	if (auto expr = parseBitCount(tok)) {
+	    return expr;
+	} else if (auto sym = Symtab::type(tok.val, Symtab::AnyScope)) {
 	    tok = token;
 	    assert(sym->type);
 	    auto expr = parseCompoundExpression(sym->type);
@@ -638,7 +695,10 @@ parsePrimary()
 	    return expr;
 	} else if (auto sym = Symtab::variable(tok.val, Symtab::AnyScope)) {
 	    auto ty = sym->type;
-	    auto expr = Identifier::create(tok.val, sym->getId(), ty, tok.loc);
+	    auto expr = Identifier::create(tok.val, sym->getId(), ty, tok.loc,
+	                                   sym->getConstExpr(),
+	                                   sym->hasExternalLinkage(),
+	                                   sym->isInParam());
 	    return expr;
 	} else {
 	    error::undefinedIdentifier(tok.loc, tok.val);
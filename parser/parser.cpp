@@ -8,9 +8,12 @@
 #include "symtab/symtab.hpp"
 #include "type/arraytype.hpp"
 #include "type/autotype.hpp"
+#include "type/fixedtype.hpp"
 #include "type/functiontype.hpp"
 #include "type/integertype.hpp"
+#include "type/packedboolarraytype.hpp"
 #include "type/pointertype.hpp"
+#include "type/soaarraytype.hpp"
 #include "type/voidtype.hpp"
 
 #include "defaultdecl.hpp"
@@ -114,7 +117,9 @@ static AstPtr parseFunctionBody(bool required = false);
 
 /*
  * function-declaration-or-definition
- *	= function-header (";" | function-body)
+ *	= function-header (";" | ["fastmath"] function-body)
+ *
+ * Like "in", "fastmath" is not a keyword.
  */
 static AstPtr
 parseFunctionDeclarationOrDefinition()
@@ -127,7 +132,13 @@ parseFunctionDeclarationOrDefinition()
 	return nullptr;
     }
 
-    if (fnType->retType()->isVoid()) {
+    bool fastMath = false;
+    if (token.kind == TokenKind::IDENTIFIER &&
+        token.val == UStr::create("fastmath")) {
+	fastMath = true;
+	getToken();
+	error::expectedAfterLastToken(TokenKind::LBRACE);
+    } else if (fnType->retType()->isVoid()) {
 	error::expectedAfterLastToken(
 	    {TokenKind::LBRACE, TokenKind::COLON, TokenKind::SEMICOLON});
     } else {
@@ -141,7 +152,7 @@ parseFunctionDeclarationOrDefinition()
 	                                     std::move(fnParamName), false);
     }
 
-    auto fnDef = std::make_unique<AstFuncDef>(fnName, fnType);
+    auto fnDef = std::make_unique<AstFuncDef>(fnName, fnType, fastMath);
 
     Symtab newScope(fnName.val);
     fnDef->appendParamName(std::move(fnParamName));
@@ -175,6 +186,7 @@ parseFunctionHeader(Token &fnName, std::vector<Token> &fnParamName)
 //------------------------------------------------------------------------------
 static bool parseFunctionParameterList(std::vector<Token> &paramName,
                                        std::vector<const Type *> &paramType,
+                                       std::vector<bool> &paramIn,
                                        bool &hasVarg);
 
 /*
@@ -203,8 +215,10 @@ parseFunctionType(Token &fnName, std::vector<Token> &fnParamName)
     getToken();
 
     std::vector<const Type *> fnParamType;
+    std::vector<bool> fnParamIn;
     bool hasVarg = false;
-    if (!parseFunctionParameterList(fnParamName, fnParamType, hasVarg)) {
+    if (!parseFunctionParameterList(fnParamName, fnParamType, fnParamIn,
+                                    hasVarg)) {
 	error::location(token.loc);
 	error::out() << error::setColor(error::BOLD) << token.loc << ": "
 	             << error::setColor(error::BOLD_RED)
@@ -233,17 +247,24 @@ parseFunctionType(Token &fnName, std::vector<Token> &fnParamName)
 	    return nullptr;
 	}
     }
-    return FunctionType::create(fnRetType, std::move(fnParamType), hasVarg);
+    return FunctionType::create(fnRetType, std::move(fnParamType),
+                                std::move(fnParamIn), hasVarg);
 }
 
 //------------------------------------------------------------------------------
 /*
  * function-parameter-list
- *	= [ [identifier] ":" type { "," [identifier] ":" type} } ["," "..."] ]
+ *	= [ function-parameter { "," function-parameter } ["," "..."] ]
+ * function-parameter
+ *	= [identifier] ":" ["in"] type
+ *
+ * "in" is not a keyword. It only marks a readonly reference parameter if it
+ * is not the name of a type.
  */
 static bool
 parseFunctionParameterList(std::vector<Token> &paramName,
-                           std::vector<const Type *> &paramType, bool &hasVarg)
+                           std::vector<const Type *> &paramType,
+                           std::vector<bool> &paramIn, bool &hasVarg)
 {
     if (!isIdentifierToken(token) && token.kind != TokenKind::COLON) {
 	return true; // empty parameter list
@@ -264,6 +285,12 @@ parseFunctionParameterList(std::vector<Token> &paramName,
 	    return false;
 	}
 	getToken();
+	bool in = false;
+	if (isIdentifierToken(token) && token.val == UStr::create("in")) {
+	    in = true;
+	    getToken();
+	}
+	auto tyLoc = token.loc;
 	auto ty = parseType();
 	if (!ty) {
 	    error::location(token.loc);
@@ -275,7 +302,20 @@ parseFunctionParameterList(std::vector<Token> &paramName,
 	    error::fatal();
 	    return false;
 	}
-	paramType.push_back(ty);
+	if (in && !ty->hasSize()) {
+	    error::location(tyLoc);
+	    error::out() << error::setColor(error::BOLD) << tyLoc << ": "
+	                 << error::setColor(error::BOLD_RED)
+	                 << "error: " << error::setColor(error::BOLD)
+	                 << "'in' parameter of incomplete type '" << ty
+	                 << "'\n"
+	                 << error::setColor(error::NORMAL);
+	    error::fatal();
+	    return false;
+	}
+	// the callee can only read an 'in' parameter
+	paramType.push_back(in ? ty->getConst() : ty);
+	paramIn.push_back(in);
 	if (token.kind != TokenKind::COMMA) {
 	    break;
 	}
@@ -408,11 +448,17 @@ parseType(bool allowZeroDim)
 //------------------------------------------------------------------------------
 static const Type *parsePointerType();
 static const Type *parseArrayType(bool allowZeroDim);
+static const Type *parseSoaArrayType();
+static const Type *parsePackedArrayType();
+static const Type *parseFixedPointType();
 
 /*
  * unqualified-type = identifier
  *		    | pointer-type
  *		    | array-type
+ *		    | soa-array-type
+ *		    | packed-array-type
+ *		    | fixed-point-type
  *		    | function-type
  */
 static const Type *
@@ -430,6 +476,12 @@ parseUnqualifiedType(bool allowZeroDim)
 	return type;
     } else if (auto type = parseArrayType(allowZeroDim)) {
 	return type;
+    } else if (auto type = parseSoaArrayType()) {
+	return type;
+    } else if (auto type = parsePackedArrayType()) {
+	return type;
+    } else if (auto type = parseFixedPointType()) {
+	return type;
     } else if (auto type = parseFunctionType(fnName, fnParamName)) {
 	return type;
     } else {
@@ -699,6 +751,17 @@ parseVariableDefinition()
 static AstInitializerExprPtr
 parseInitializerExpression(const Type *type)
 {
+    if (type->isSoaArray() || type->isPackedBoolArray() ||
+        type->hasBitFields()) {
+	error::location(token.loc);
+	error::out() << error::setColor(error::BOLD) << token.loc << ": "
+	             << error::setColor(error::BOLD_RED)
+	             << "error: " << error::setColor(error::BOLD)
+	             << "'" << type << "' can not have an initializer\n"
+	             << error::setColor(error::NORMAL);
+	error::fatal();
+	return nullptr;
+    }
     if (type->isArray() && type->refType()->isAuto()) {
 	if (token.kind != TokenKind::LBRACE) {
 	    error::location(token.loc);
@@ -1114,9 +1177,55 @@ parseDoWhileStatement()
 
 //------------------------------------------------------------------------------
 /*
- * for-statement = "for" "(" [expression-or-variable-definition]
- *			[expression-list] ";" [expression-list] ")"
+ * for-range = identifier ["," identifier] "in" assignment-expression
+ *
+ * "in" is not a keyword. If the tokens do not start a for-range they are
+ * pushed back to the lexer and nullptr is returned.
+ */
+static std::unique_ptr<AstFor>
+parseForRange()
+{
+    if (!isIdentifierToken(token)) {
+	return nullptr;
+    }
+    std::vector<Token> name{token};
+    getToken();
+    if (token.kind == TokenKind::COMMA) {
+	name.push_back(token);
+	getToken();
+	if (isIdentifierToken(token)) {
+	    name.push_back(token);
+	    getToken();
+	}
+    }
+    if (name.size() == 2 || !isIdentifierToken(token) ||
+        token.val != UStr::create("in")) {
+	for (auto it = name.rbegin(); it != name.rend(); ++it) {
+	    ungetToken(*it);
+	}
+	return nullptr;
+    }
+    getToken();
+    auto range = parseAssignmentExpression();
+    if (!range) {
+	error::location(token.loc);
+	error::out() << error::setColor(error::BOLD) << token.loc << ": "
+	             << error::setColor(error::BOLD_RED)
+	             << "error: " << error::setColor(error::BOLD)
+	             << "expected array expression\n"
+	             << error::setColor(error::NORMAL);
+	error::fatal();
+	return nullptr;
+    }
+    auto index = name.size() == 3 ? name[0] : Token{};
+    return std::make_unique<AstFor>(index, name.back(), std::move(range));
+}
+
+/*
+ * for-statement = "for" "(" (for-range | for-init-cond-update) ")"
  *			compound-statement
+ *  for-init-cond-update = [expression-or-variable-definition]
+ *			   [expression-list] ";" [expression-list]
  *  expression-or-variable-definition = expression-list ";"
  *				      | local-variable-definition
  */
@@ -1133,32 +1242,34 @@ parseForStatement()
     getToken();
 
     Symtab newScope;
-    AstPtr forInitDecl;
-    ExprPtr forInitExpr;
-    if (!(forInitDecl = parseLocalVariableDefinition())) {
-	forInitExpr = parseExpressionList();
+    auto forLoop = parseForRange();
+    if (!forLoop) {
+	AstPtr forInitDecl;
+	ExprPtr forInitExpr;
+	if (!(forInitDecl = parseLocalVariableDefinition())) {
+	    forInitExpr = parseExpressionList();
+	    if (!error::expected(TokenKind::SEMICOLON)) {
+		return nullptr;
+	    }
+	    getToken();
+	}
+	auto forCond = parseExpressionList();
 	if (!error::expected(TokenKind::SEMICOLON)) {
 	    return nullptr;
 	}
 	getToken();
+	auto forUpdate = parseExpressionList();
+	forLoop = forInitDecl ? std::make_unique<AstFor>(std::move(forInitDecl),
+	                                                 std::move(forCond),
+	                                                 std::move(forUpdate))
+	                      : std::make_unique<AstFor>(std::move(forInitExpr),
+	                                                 std::move(forCond),
+	                                                 std::move(forUpdate));
     }
-    auto forCond = parseExpressionList();
-    if (!error::expected(TokenKind::SEMICOLON)) {
-	return nullptr;
-    }
-    getToken();
-    auto forUpdate = parseExpressionList();
     if (!error::expected(TokenKind::RPAREN)) {
 	return nullptr;
     }
     getToken();
-    auto forLoop =
-        forInitDecl
-            ? std::make_unique<AstFor>(std::move(forInitDecl),
-                                       std::move(forCond), std::move(forUpdate))
-            : std::make_unique<AstFor>(std::move(forInitExpr),
-                                       std::move(forCond),
-                                       std::move(forUpdate));
     auto forBody = parseFunctionBody(true);
     if (!forBody) {
 	error::location(token.loc);
@@ -1234,6 +1345,7 @@ parseContinueStatement()
 //------------------------------------------------------------------------------
 /*
  * goto-statement = "goto" identifier ";"
+ *                | "goto" "*" expression ";"
  */
 static AstPtr
 parseGotoStatement()
@@ -1242,6 +1354,37 @@ parseGotoStatement()
 	return nullptr;
     }
     getToken();
+    if (token.kind == TokenKind::ASTERISK) {
+	auto loc = token.loc;
+	getToken();
+	auto labelAddress = parseExpressionList();
+	if (!labelAddress) {
+	    error::location(token.loc);
+	    error::out() << error::setColor(error::BOLD) << token.loc << ": "
+	                 << error::setColor(error::BOLD_RED)
+	                 << "error: " << error::setColor(error::BOLD)
+	                 << "expression expected\n"
+	                 << error::setColor(error::NORMAL);
+	    error::fatal();
+	    return nullptr;
+	}
+	auto ty = labelAddress->type;
+	if (!ty->isPointer() || ty->isNullptr() || !ty->refType()->isVoid()) {
+	    error::location(labelAddress->loc);
+	    error::out() << error::setColor(error::BOLD) << labelAddress->loc
+	                 << ": " << error::setColor(error::BOLD_RED)
+	                 << "error: " << error::setColor(error::BOLD)
+	                 << "label address of type '-> void' expected\n"
+	                 << error::setColor(error::NORMAL);
+	    error::fatal();
+	    return nullptr;
+	}
+	if (!error::expectedAfterLastToken(TokenKind::SEMICOLON)) {
+	    return nullptr;
+	}
+	getToken();
+	return std::make_unique<AstGoto>(loc, std::move(labelAddress));
+    }
     auto label = token;
     if (!error::expectedAfterLastToken(TokenKind::IDENTIFIER)) {
 	return nullptr;
@@ -1507,8 +1650,17 @@ parseStructDeclaration()
 }
 
 //------------------------------------------------------------------------------
+// Storage unit that consecutive bit-fields of the same size share
+struct BitFieldUnit
+{
+    bool open = false;
+    std::size_t index = 0;
+    std::size_t numBits = 0;
+    std::size_t usedBits = 0;
+};
+
 static bool parseStructMemberList(AstStructDecl *structDecl, std::size_t &index,
-                                  bool unionSection);
+                                  bool unionSection, BitFieldUnit &unit);
 
 /*
  * struct-member-declaration = "{" { struct-member-list } "}" ";"
@@ -1523,6 +1675,7 @@ parseStructMemberDeclaration(AstStructDecl *structDecl)
 
     bool unionSection = false;
     std::size_t index = 0;
+    BitFieldUnit unit;
     while (true) {
 	if (token.kind == TokenKind::UNION) {
 	    if (!unionSection) {
@@ -1542,7 +1695,7 @@ parseStructMemberDeclaration(AstStructDecl *structDecl)
 		error::fatal();
 	    }
 	}
-	if (!parseStructMemberList(structDecl, index, unionSection)) {
+	if (!parseStructMemberList(structDecl, index, unionSection, unit)) {
 	    if (unionSection) {
 		error::location(token.loc);
 		error::out() << error::setColor(error::BOLD) << token.loc
@@ -1577,19 +1730,24 @@ parseStructMemberDeclaration(AstStructDecl *structDecl)
 }
 
 //------------------------------------------------------------------------------
+static std::size_t parseBitFieldWidth(const Type *type);
+
 /*
  * struct-member-list
- *	= identifier { "," identifier } ":" ( type ";" | struct-declaration )
+ *	= identifier { "," identifier } ":"
+ *	  ( type [":" assignment-expression] ";" | struct-declaration )
+ *
+ * A member with ": width" is a bit-field. Consecutive bit-fields share a
+ * storage unit of their type as long as their bits fit into it.
  */
 static bool
 parseStructMemberList(AstStructDecl *structDecl, std::size_t &index,
-                      bool unionSection)
+                      bool unionSection, BitFieldUnit &unit)
 {
     if (!isIdentifierToken(token)) {
 	return false;
     }
     std::vector<lexer::Token> memberName;
-    std::vector<std::size_t> memberIndex;
 
     while (true) {
 	if (!isIdentifierToken(token)) {
@@ -1600,10 +1758,6 @@ parseStructMemberList(AstStructDecl *structDecl, std::size_t &index,
 	    return false;
 	}
 	memberName.push_back(token);
-	memberIndex.push_back(index);
-	if (!unionSection) {
-	    ++index;
-	}
 	getToken();
 	if (token.kind != TokenKind::COMMA) {
 	    break;
@@ -1615,12 +1769,48 @@ parseStructMemberList(AstStructDecl *structDecl, std::size_t &index,
     }
     getToken();
     auto type = parseType();
+    std::size_t bitWidth = 0;
+    if (type && token.kind == TokenKind::COLON) {
+	auto loc = token.loc;
+	getToken();
+	bitWidth = parseBitFieldWidth(type);
+	if (unionSection) {
+	    error::location(loc);
+	    error::out() << error::setColor(error::BOLD) << loc << ": "
+	                 << error::setColor(error::BOLD_RED)
+	                 << "error: " << error::setColor(error::BOLD)
+	                 << "bit-fields are not allowed in union blocks\n"
+	                 << error::setColor(error::NORMAL);
+	    error::fatal();
+	    return false;
+	}
+    }
+
+    std::vector<std::size_t> memberIndex;
+    for (std::size_t i = 0; i < memberName.size(); ++i) {
+	if (!bitWidth) {
+	    unit.open = false;
+	    memberIndex.push_back(index);
+	    if (!unionSection) {
+		++index;
+	    }
+	    continue;
+	}
+	if (!unit.open || unit.numBits != type->numBits() ||
+	    unit.usedBits + bitWidth > unit.numBits) {
+	    unit = BitFieldUnit{true, index++, type->numBits(), 0};
+	}
+	unit.usedBits += bitWidth;
+	memberIndex.push_back(unit.index);
+    }
+
     if (type) {
 	if (!error::expected(TokenKind::SEMICOLON)) {
 	    return false;
 	}
 	getToken();
-	structDecl->add(std::move(memberName), std::move(memberIndex), type);
+	structDecl->add(std::move(memberName), std::move(memberIndex), type,
+	                bitWidth);
 	return true;
     } else if (auto ast = parseStructDeclaration()) {
 	structDecl->add(std::move(memberName), std::move(memberIndex),
@@ -1638,6 +1828,56 @@ parseStructMemberList(AstStructDecl *structDecl, std::size_t &index,
     }
 }
 
+//------------------------------------------------------------------------------
+/*
+ * bit-field-width = assignment-expression
+ *
+ * The width has to be a constant between 1 and the number of bits of the
+ * integer type of the bit-field.
+ */
+static std::size_t
+parseBitFieldWidth(const Type *type)
+{
+    auto loc = token.loc;
+    if (!type->isInteger() || type->isBool()) {
+	error::location(loc);
+	error::out() << error::setColor(error::BOLD) << loc << ": "
+	             << error::setColor(error::BOLD_RED)
+	             << "error: " << error::setColor(error::BOLD)
+	             << "bit-field of type '" << type
+	             << "', integer type expected\n"
+	             << error::setColor(error::NORMAL);
+	error::fatal();
+	return 0;
+    }
+    auto widthExpr = parseAssignmentExpression();
+    if (!widthExpr || !widthExpr->isConst() ||
+        !widthExpr->type->isInteger()) {
+	error::location(loc);
+	error::out() << error::setColor(error::BOLD) << loc << ": "
+	             << error::setColor(error::BOLD_RED)
+	             << "error: " << error::setColor(error::BOLD)
+	             << "constant integer expression expected for bit-field "
+	             << "width\n"
+	             << error::setColor(error::NORMAL);
+	error::fatal();
+	return 0;
+    }
+    auto width = widthExpr->getSignedIntValue();
+    if (width <= 0 || std::size_t(width) > type->numBits()) {
+	error::location(loc);
+	error::out() << error::setColor(error::BOLD) << loc << ": "
+	             << error::setColor(error::BOLD_RED)
+	             << "error: " << error::setColor(error::BOLD)
+	             << "bit-field width has to be between 1 and "
+	             << type->numBits() << "\n"
+	             << error::setColor(error::NORMAL);
+	error::fatal();
+	return 0;
+    }
+    return width;
+}
+
 //------------------------------------------------------------------------------
 /*
  * pointer-type = "->" type
@@ -1690,6 +1930,193 @@ parseArrayType(bool allowZeroDim)
     return type;
 }
 
+//------------------------------------------------------------------------------
+/*
+ * soa-array-type = "soa" "array" "[" assignment-expression "]" "of" type
+ *
+ * "soa" is not a keyword, it only starts a type if "array" follows. The
+ * element type has to be a complete struct.
+ */
+static const Type *
+parseSoaArrayType()
+{
+    if (!isIdentifierToken(token) || token.val != UStr::create("soa")) {
+	return nullptr;
+    }
+    auto soaToken = token;
+    getToken();
+    if (token.kind != TokenKind::ARRAY) {
+	// for example '(soa + 1)' with a variable 'soa'
+	ungetToken(soaToken);
+	return nullptr;
+    }
+    getToken();
+    auto loc = soaToken.loc;
+    auto type = parseArrayDimAndType();
+    if (!type) {
+	error::location(token.loc);
+	error::out() << error::setColor(error::BOLD) << token.loc << ": "
+	             << error::setColor(error::BOLD_RED)
+	             << "error: " << error::setColor(error::BOLD)
+	             << "array type expected\n"
+	             << error::setColor(error::NORMAL);
+	error::fatal();
+	return nullptr;
+    }
+    if (type->refType()->isArray() || !type->refType()->isStruct() ||
+        !type->refType()->hasSize()) {
+	error::location(loc);
+	error::out() << error::setColor(error::BOLD) << loc << ": "
+	             << error::setColor(error::BOLD_RED)
+	             << "error: " << error::setColor(error::BOLD)
+	             << "element type of a soa array has to be a complete "
+	             << "struct\n"
+	             << error::setColor(error::NORMAL);
+	error::fatal();
+	return nullptr;
+    }
+    return SoaArrayType::create(type->refType(), type->dim());
+}
+
+//------------------------------------------------------------------------------
+/*
+ * packed-array-type = "packed" "array" "[" assignment-expression "]" "of" type
+ *
+ * Like "soa", "packed" is not a keyword. The element type has to be bool.
+ */
+static const Type *
+parsePackedArrayType()
+{
+    if (!isIdentifierToken(token) || token.val != UStr::create("packed")) {
+	return nullptr;
+    }
+    auto packedToken = token;
+    getToken();
+    if (token.kind != TokenKind::ARRAY) {
+	ungetToken(packedToken);
+	return nullptr;
+    }
+    getToken();
+    auto loc = packedToken.loc;
+    auto type = parseArrayDimAndType();
+    if (!type) {
+	error::location(token.loc);
+	error::out() << error::setColor(error::BOLD) << token.loc << ": "
+	             << error::setColor(error::BOLD_RED)
+	             << "error: " << error::setColor(error::BOLD)
+	             << "array type expected\n"
+	             << error::setColor(error::NORMAL);
+	error::fatal();
+	return nullptr;
+    }
+    if (type->refType()->isArray() || !type->refType()->isBool()) {
+	error::location(loc);
+	error::out() << error::setColor(error::BOLD) << loc << ": "
+	             << error::setColor(error::BOLD_RED)
+	             << "error: " << error::setColor(error::BOLD)
+	             << "element type of a packed array has to be bool\n"
+	             << error::setColor(error::NORMAL);
+	error::fatal();
+	return nullptr;
+    }
+    auto packedType = PackedBoolArrayType::create(type->dim());
+    return type->refType()->hasConstFlag() ? packedType->getConst()
+                                           : packedType;
+}
+
+//------------------------------------------------------------------------------
+static std::size_t parseFixedPointBits(const char *what);
+
+/*
+ * fixed-point-type = ("fixed" | "ufixed")
+ *			"[" assignment-expression "," assignment-expression "]"
+ *
+ * The first expression is the number of integer bits (for "fixed" including
+ * the sign bit), the second the number of fraction bits. Together they have
+ * to be 8, 16, 32 or 64. Like "soa", "fixed" and "ufixed" are not keywords
+ * and they are not recognized if a variable or constant with that name
+ * exists.
+ */
+static const Type *
+parseFixedPointType()
+{
+    if (!isIdentifierToken(token)) {
+	return nullptr;
+    }
+    bool isSigned = token.val == UStr::create("fixed");
+    if (!isSigned && token.val != UStr::create("ufixed")) {
+	return nullptr;
+    }
+    if (Symtab::variable(token.val, Symtab::AnyScope) ||
+        Symtab::constant(token.val, Symtab::AnyScope)) {
+	return nullptr;
+    }
+    auto fixedToken = token;
+    getToken();
+    if (token.kind != TokenKind::LBRACKET) {
+	ungetToken(fixedToken);
+	return nullptr;
+    }
+    getToken();
+    auto intBits = parseFixedPointBits("integer");
+    if (!error::expected(TokenKind::COMMA)) {
+	return nullptr;
+    }
+    getToken();
+    auto fracBits = parseFixedPointBits("fraction");
+    if (!error::expected(TokenKind::RBRACKET)) {
+	return nullptr;
+    }
+    getToken();
+
+    auto loc = fixedToken.loc;
+    auto numBits = intBits + fracBits;
+    if (numBits != 8 && numBits != 16 && numBits != 32 && numBits != 64) {
+	error::location(loc);
+	error::out() << error::setColor(error::BOLD) << loc << ": "
+	             << error::setColor(error::BOLD_RED)
+	             << "error: " << error::setColor(error::BOLD)
+	             << "fixed-point type has " << numBits
+	             << " bits, expected 8, 16, 32 or 64\n"
+	             << error::setColor(error::NORMAL);
+	error::fatal();
+	return nullptr;
+    }
+    if (isSigned && intBits == 0) {
+	error::location(loc);
+	error::out() << error::setColor(error::BOLD) << loc << ": "
+	             << error::setColor(error::BOLD_RED)
+	             << "error: " << error::setColor(error::BOLD)
+	             << "signed fixed-point type needs an integer bit for the "
+	             << "sign\n"
+	             << error::setColor(error::NORMAL);
+	error::fatal();
+	return nullptr;
+    }
+    return isSigned ? FixedType::createSigned(intBits, fracBits)
+                    : FixedType::createUnsigned(intBits, fracBits);
+}
+
+static std::size_t
+parseFixedPointBits(const char *what)
+{
+    auto loc = token.loc;
+    auto bitsExpr = parseAssignmentExpression();
+    if (!bitsExpr || !bitsExpr->isConst() || !bitsExpr->type->isInteger() ||
+        bitsExpr->getSignedIntValue() < 0) {
+	error::location(loc);
+	error::out() << error::setColor(error::BOLD) << loc << ": "
+	             << error::setColor(error::BOLD_RED)
+	             << "error: " << error::setColor(error::BOLD)
+	             << "non-negative constant expected for the number of "
+	             << what << " bits\n"
+	             << error::setColor(error::NORMAL);
+	error::fatal();
+	return 0;
+    }
+    return bitsExpr->getSignedIntValue();
+}
+
 //------------------------------------------------------------------------------
 /*
  * array-dim-and-type = "[" assignment-expression "]" { "["
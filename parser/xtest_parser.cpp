@@ -72,7 +72,7 @@ main(int argc, char *argv[])
     gen::init(infile.stem().c_str());
 
     if (auto ast = abc::parser()) {
-	ast->print();
+	ast->print(std::cerr);
 	ast->codegen();
 	std::cerr << "generating " << outfile.c_str() << "\n";
 	gen::print(outfile.c_str());
@@ -0,0 +1,120 @@
+#include <forward_list>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "lexer/loc.hpp"
+#include "type/inittypesystem.hpp"
+#include "type/integertype.hpp"
+#include "util/bench.hpp"
+
+#include "symtab.hpp"
+
+static std::vector<abc::UStr>
+randomNames(std::mt19937_64 &rng, std::size_t num, const char *prefix)
+{
+    std::uniform_int_distribution<int> ch('a', 'z');
+
+    std::vector<abc::UStr> name;
+    for (std::size_t i = 0; i < num; ++i) {
+	std::string s{prefix};
+	for (int n = 0; n < 6; ++n) {
+	    s += char(ch(rng));
+	}
+	name.push_back(abc::UStr::create(s + std::to_string(i)));
+    }
+    return name;
+}
+
+int
+main(int argc, char *argv[])
+{
+    using namespace abc;
+
+    bench::init(argc, argv);
+    std::mt19937_64 rng{bench::config.seed};
+    initTypeSystem();
+
+    constexpr std::size_t numNames = 1024;
+    constexpr std::size_t depth = 8;
+
+    auto local = randomNames(rng, numNames, "local_");
+    auto global = randomNames(rng, numNames, "global_");
+    auto unknown = randomNames(rng, numNames, "unknown_");
+    auto ty = IntegerType::createInt();
+
+    Symtab root;
+    for (auto name : global) {
+	Symtab::addDeclaration(lexer::Loc{}, name, ty);
+    }
+
+    // function scope plus nested blocks
+    std::optional<Symtab> fnScope;
+    std::forward_list<Symtab> blockScope;
+
+    auto openScopes = [&] {
+	blockScope.clear();
+	fnScope.reset();
+	fnScope.emplace(UStr::create("fn"));
+	for (std::size_t i = 1; i < depth; ++i) {
+	    blockScope.emplace_front();
+	}
+    };
+    auto addLocals = [&] {
+	for (auto name : local) {
+	    Symtab::addDefinition(lexer::Loc{}, name, ty);
+	}
+    };
+
+    bench::run("Symtab::addDefinition", numNames, openScopes, addLocals);
+
+    // typical block: a few declarations, then the scope is closed again
+    bench::run("Symtab block scope", numNames, openScopes, [&] {
+	for (std::size_t i = 0; i < numNames; i += 2) {
+	    Symtab block;
+	    Symtab::addDefinition(lexer::Loc{}, local[i], ty);
+	    Symtab::addDefinition(lexer::Loc{}, local[i + 1], ty);
+	    bench::doNotOptimize(Symtab::find(local[i], Symtab::CurrentScope));
+	}
+    });
+
+    openScopes();
+    addLocals();
+
+    bench::run("Symtab::find current scope", numNames, [&] {
+	for (auto name : local) {
+	    bench::doNotOptimize(Symtab::find(name, Symtab::CurrentScope));
+	}
+    });
+
+    bench::run("Symtab::find root scope", numNames, [&] {
+	for (auto name : global) {
+	    bench::doNotOptimize(Symtab::find(name, Symtab::AnyScope));
+	}
+    });
+
+    bench::run("Symtab::find miss", numNames, [&] {
+	for (auto name : unknown) {
+	    bench::doNotOptimize(Symtab::find(name, Symtab::AnyScope));
+	}
+    });
+
+    // misspelled local names: one character replaced
+    std::vector<UStr> typo;
+    for (auto name : local) {
+	std::string s{name.c_str()};
+	s[s.length() / 2] = '_';
+	typo.push_back(UStr::create(s));
+    }
+
+    bench::run("Symtab::didYouMean", numNames, [&] {
+	for (auto name : typo) {
+	    bench::doNotOptimize(Symtab::didYouMean(name));
+	}
+    });
+
+    blockScope.clear();
+    fnScope.reset();
+    bench::report("symtab");
+}
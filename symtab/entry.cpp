@@ -105,6 +105,39 @@ Entry::setLinkage()
     return true;
 }
 
+bool
+Entry::hasExternalLinkage() const
+{
+    return linkage == EXTERNAL_LINKAGE;
+}
+
+void
+Entry::setConstExpr(const Expr *constExpr)
+{
+    assert(variableDeclaration());
+    assert(constExpr->isConst());
+    this->constExpr = constExpr;
+}
+
+const Expr *
+Entry::getConstExpr() const
+{
+    return constExpr;
+}
+
+void
+Entry::setInParam()
+{
+    assert(variableDeclaration());
+    inParamFlag = true;
+}
+
+bool
+Entry::isInParam() const
+{
+    return inParamFlag;
+}
+
 bool
 operator!=(const Entry &a, const Entry &b)
 {
@@ -31,6 +31,8 @@ class Entry
 	bool definitionFlag = false;
 	Linkage linkage = NO_LINKAGE;
 	UStr id;
+	const Expr *constExpr = nullptr;
+	bool inParamFlag = false;
 
     public:
 	static Entry createVarEntry(lexer::Loc loc, UStr id, const Type *type);
@@ -53,6 +55,17 @@ class Entry
 	bool setExternalLinkage();
 	bool setInternalLinkage();
 	bool setLinkage();
+	bool hasExternalLinkage() const;
+
+	// for global constants: uses of the variable are folded to the value
+	// of its initializer 'constExpr'
+	void setConstExpr(const Expr *constExpr);
+	const Expr *getConstExpr() const;
+
+	// for 'in' parameters: the address of the caller's object must not
+	// escape the call
+	void setInParam();
+	bool isInParam() const;
 
 	friend bool operator!=(const Entry &a, const Entry &b);
 };
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <utility>
+
+#include "nameindex.hpp"
+
+namespace abc {
+namespace symtab {
+
+void
+NameIndex::add(UStr name)
+{
+    if (bucket.size() <= name.length()) {
+	bucket.resize(name.length() + 1);
+    }
+    bucket[name.length()].push_back(name);
+}
+
+void
+NameIndex::find(UStr name, unsigned max, std::vector<std::string> &list) const
+{
+    auto len = name.length();
+    auto from = len > max ? len - max : 0;
+    auto to = std::min(len + max + 1, bucket.size());
+
+    for (auto l = from; l < to; ++l) {
+	for (auto candidate : bucket[l]) {
+	    if (boundedEditDistance(candidate.c_str(), candidate.length(),
+	                            name.c_str(), len, max) <= max) {
+		list.push_back(candidate.c_str());
+	    }
+	}
+    }
+}
+
+unsigned
+boundedEditDistance(const char *a, std::size_t aLen, const char *b,
+                    std::size_t bLen, unsigned max)
+{
+    if (aLen > bLen) {
+	std::swap(a, b);
+	std::swap(aLen, bLen);
+    }
+    if (bLen - aLen > max) {
+	return max + 1;
+    }
+
+    // Only cells (i, j) with |i - j| <= max can have a value <= max. Cells
+    // outside this band are treated as 'max + 1'. Rows are reused between
+    // calls so that a lookup does not allocate.
+    static std::vector<unsigned> prev, cur;
+    if (prev.size() < bLen + 2) {
+	prev.resize(bLen + 2);
+	cur.resize(bLen + 2);
+    }
+    for (std::size_t j = 0; j <= bLen + 1; ++j) {
+	prev[j] = j <= max ? j : max + 1;
+    }
+
+    for (std::size_t i = 1; i <= aLen; ++i) {
+	auto from = i > max ? i - max : 1;
+	auto to = std::min(bLen, i + max);
+
+	cur[from - 1] = from == 1 && i <= max ? i : max + 1;
+	auto rowMin = cur[from - 1];
+	for (auto j = from; j <= to; ++j) {
+	    unsigned cost = a[i - 1] == b[j - 1] ? 0 : 1;
+	    auto d = std::min({prev[j - 1] + cost, prev[j] + 1, cur[j - 1] + 1});
+	    cur[j] = std::min(d, max + 1);
+	    rowMin = std::min(rowMin, cur[j]);
+	}
+	cur[to + 1] = max + 1;
+
+	// early exit: distances can not decrease in later rows
+	if (rowMin > max) {
+	    return max + 1;
+	}
+	std::swap(prev, cur);
+    }
+    return prev[bLen];
+}
+
+} // namespace symtab
+} // namespace abc
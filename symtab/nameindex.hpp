@@ -0,0 +1,34 @@
+#ifndef SYMTAB_NAMEINDEX
+#define SYMTAB_NAMEINDEX
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "util/ustr.hpp"
+
+namespace abc {
+namespace symtab {
+
+// Names of a scope bucketed by length. For a query with maximal edit
+// distance 'max' only the buckets for lengths len - max, ..., len + max need
+// to be searched.
+class NameIndex
+{
+    public:
+	void add(UStr name);
+	void find(UStr name, unsigned max, std::vector<std::string> &list) const;
+
+    private:
+	std::vector<std::vector<UStr>> bucket;
+};
+
+// Levenshtein distance of 'a' and 'b' if it is at most 'max'. Otherwise
+// 'max + 1' is returned.
+unsigned boundedEditDistance(const char *a, std::size_t aLen, const char *b,
+                             std::size_t bLen, unsigned max);
+
+} // namespace symtab
+} // namespace abc
+
+#endif // SYMTAB_NAMEINDEX
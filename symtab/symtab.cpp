@@ -1,69 +1,100 @@
 #include <cassert>
+#include <charconv>
 #include <iostream>
-#include <sstream>
 #include <string>
 #include <unordered_map>
 
-#include "gen/editdistance.hpp"
 #include "lexer/error.hpp"
+#include "util/stats.hpp"
 
 #include "symtab.hpp"
 
 namespace abc {
 
-std::forward_list<std::unique_ptr<Symtab::ScopeNode>> Symtab::scope;
-std::size_t Symtab::scopeSize;
+std::deque<std::pair<UStr, symtab::Entry>> Symtab::scopeEntry;
+std::vector<Symtab::ScopeFrame> Symtab::scope;
 UStr Symtab::scopePrefix;
+bool Symtab::keepNames = true;
 std::size_t idCount;
 
 Symtab::Symtab(UStr scopePrefix_)
 {
     // prefix required one below root scope (identify function)
-    assert((scopeSize == 1 && scopePrefix_.c_str()) ||
-           (scopeSize != 1 && !scopePrefix_.c_str()));
+    assert((scope.size() == 1 && scopePrefix_.c_str()) ||
+           (scope.size() != 1 && !scopePrefix_.c_str()));
 
-    if (scopePrefix_.c_str() || scopeSize == 0) {
+    if (scopePrefix_.c_str() || scope.empty()) {
 	scopePrefix = scopePrefix_;
 	idCount = 0;
     }
-    scope.push_front(std::make_unique<ScopeNode>());
-    ++scopeSize;
+    scope.push_back({scopeEntry.size(), nullptr, nullptr});
 }
 
 Symtab::~Symtab()
 {
-    scope.pop_front();
-    --scopeSize;
+    while (scopeEntry.size() > scope.back().begin) {
+	scopeEntry.pop_back();
+    }
+    scope.pop_back();
 }
 
 std::vector<std::string>
-Symtab::didYouMean(UStr name_)
+Symtab::didYouMean(UStr name)
 {
     std::vector<std::string> list;
-    std::string name{name_.c_str()};
 
     unsigned max = 2;
-    for (auto s = scope.cbegin(); s != scope.cend(); ++s, max = 1) {
-	for (const auto &node : **s) {
-	    if (!node.second.typeDeclaration()) {
-		std::string id{node.first.c_str()};
-		if (gen::editDistance(id, name) <= max) {
-		    list.push_back(id);
+    for (auto level = scope.size(); level-- > 0; max = 1) {
+	auto &frame = scope[level];
+	if (!frame.nameIndex) {
+	    auto end = scopeEnd(level);
+	    frame.nameIndex = std::make_unique<symtab::NameIndex>();
+	    for (auto i = frame.begin; i < end; ++i) {
+		if (!scopeEntry[i].second.typeDeclaration()) {
+		    frame.nameIndex->add(scopeEntry[i].first);
 		}
 	    }
 	}
+	frame.nameIndex->find(name, max, list);
     }
     return list;
 }
 
+// one past the last entry of scope 'level'
+std::size_t
+Symtab::scopeEnd(std::size_t level)
+{
+    return level + 1 < scope.size() ? scope[level + 1].begin
+                                    : scopeEntry.size();
+}
+
+symtab::Entry *
+Symtab::findInScope(std::size_t level, UStr name)
+{
+    const auto &frame = scope[level];
+    if (frame.index) {
+	stats::count(stats::SYMTAB_PROBES);
+	auto found = frame.index->find(name);
+	return found != frame.index->end() ? found->second : nullptr;
+    }
+
+    auto end = scopeEnd(level);
+    for (auto i = frame.begin; i < end; ++i) {
+	stats::count(stats::SYMTAB_PROBES);
+	if (scopeEntry[i].first == name) {
+	    return &scopeEntry[i].second;
+	}
+    }
+    return nullptr;
+}
+
 const symtab::Entry *
 Symtab::find(UStr name, Scope inScope)
 {
-    for (auto s = scope.cbegin(); s != scope.cend(); ++s) {
-	for (const auto &node : **s) {
-	    if (node.first == name) {
-		return &node.second;
-	    }
+    stats::count(stats::SYMTAB_LOOKUPS);
+    for (auto level = scope.size(); level-- > 0;) {
+	if (auto found = findInScope(level, name)) {
+	    return found;
 	}
 	if (inScope == CurrentScope) {
 	    break;
@@ -150,8 +181,10 @@ void
 Symtab::print(std::ostream &out)
 {
     out << "Symtab (from current scope to root scope):\n";
-    std::for_each(scope.begin(), scope.end(), [&](const auto &s) {
-	for (const auto &item : *s) {
+    for (auto level = scope.size(); level-- > 0;) {
+	auto end = scopeEnd(level);
+	for (auto i = scope[level].begin; i < end; ++i) {
+	    const auto &item = scopeEntry[i];
 	    out << item.first << ": " << item.second.getId() << ", ";
 	    if (item.second.expressionDeclaration()) {
 		out << item.second.expr;
@@ -161,15 +194,21 @@ Symtab::print(std::ostream &out)
 	    out << "\n";
 	}
 	out << "---\n";
-    });
+    }
     out << "End of symtab\n";
 }
 
+void
+Symtab::keepLocalNames(bool keep)
+{
+    keepNames = keep;
+}
+
 std::pair<symtab::Entry *, bool>
 Symtab::add(UStr name, symtab::Entry &&entry)
 {
-    if (scope.front()->contains(name)) {
-	auto &found = scope.front()->at(name);
+    if (auto foundPtr = findInScope(scope.size() - 1, name)) {
+	auto &found = *foundPtr;
 
 	bool changed = false;
 	if (entry != found) {
@@ -212,23 +251,50 @@ Symtab::add(UStr name, symtab::Entry &&entry)
 	return {&found, changed};
     }
 
-    auto added = scope.front()->insert({name, std::move(entry)});
-    assert(added.second);
-    return {&(*added.first).second, true};
+    auto &frame = scope.back();
+    auto &added = scopeEntry.emplace_back(name, std::move(entry));
+    if (frame.index) {
+	frame.index->emplace(name, &added.second);
+    } else if (scopeEntry.size() - frame.begin > indexThreshold) {
+	frame.index =
+	    std::make_unique<std::unordered_map<UStr, symtab::Entry *>>();
+	for (auto i = frame.begin; i < scopeEntry.size(); ++i) {
+	    frame.index->emplace(scopeEntry[i].first,
+	                         &scopeEntry[i].second);
+	}
+    }
+    if (frame.nameIndex && !added.second.typeDeclaration()) {
+	frame.nameIndex->add(name);
+    }
+    return {&added.second, true};
 }
 
 UStr
 Symtab::getId(UStr name)
 {
     assert(!name.empty());
-    std::string idStr = name.c_str();
-    if (scopeSize > 1) {
-	assert(scopePrefix.c_str());
-	std::stringstream ss;
-	ss << "." << scopePrefix.c_str() << "." << idStr << "." << idCount++;
-	idStr = ss.str();
-    }
-    return UStr::create(idStr);
+    if (scope.size() <= 1) {
+	return name;
+    }
+    assert(scopePrefix.c_str());
+
+    // ".<prefix>.<name>.<count>" or, if value names are discarded, just
+    // ".<prefix>.<count>". The prefix is still required as local static
+    // variables become globals with this name.
+    char count[24];
+    auto countEnd = std::to_chars(count, count + sizeof(count), idCount++).ptr;
+
+    std::string id;
+    id.reserve(scopePrefix.length() + name.length() + sizeof(count) + 3);
+    id += '.';
+    id.append(scopePrefix.c_str(), scopePrefix.length());
+    id += '.';
+    if (keepNames) {
+	id.append(name.c_str(), name.length());
+	id += '.';
+    }
+    id.append(count, countEnd);
+    return UStr::create(id);
 }
 
 } // namespace abc
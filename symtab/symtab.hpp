@@ -2,7 +2,7 @@
 #define SYMTAB_SYMTAB
 
 #include <cstddef>
-#include <forward_list>
+#include <deque>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -12,6 +12,7 @@
 #include "lexer/loc.hpp"
 
 #include "entry.hpp"
+#include "nameindex.hpp"
 
 namespace abc {
 
@@ -48,16 +49,35 @@ class Symtab
 
 	static void print(std::ostream &out);
 
+	// Local IDs contain the name of the variable unless 'keep' is false
+	// (i.e. value names get discarded in the IR)
+	static void keepLocalNames(bool keep);
+
     private:
 	static std::pair<symtab::Entry *, bool> add(UStr name,
 	                                            symtab::Entry &&entry);
 
 	static UStr getId(UStr name);
 
-	using ScopeNode = std::unordered_map<UStr, symtab::Entry>;
-	static std::forward_list<std::unique_ptr<ScopeNode>> scope;
-	static std::size_t scopeSize;
+	// Entries of all open scopes, from root scope to current scope. A
+	// deque keeps pointers to entries valid when more are appended.
+	static std::deque<std::pair<UStr, symtab::Entry>> scopeEntry;
+
+	struct ScopeFrame
+	{
+	    std::size_t begin; // first entry of this scope
+	    // only for scopes with more than 'indexThreshold' entries
+	    std::unique_ptr<std::unordered_map<UStr, symtab::Entry *>> index;
+	    // variables and constants for didYouMean, created on first use
+	    std::unique_ptr<symtab::NameIndex> nameIndex;
+	};
+	static constexpr std::size_t indexThreshold = 8;
+	static std::vector<ScopeFrame> scope;
 	static UStr scopePrefix;
+	static bool keepNames;
+
+	static std::size_t scopeEnd(std::size_t level);
+	static symtab::Entry *findInScope(std::size_t level, UStr name);
 };
 
 } // namespace abc
@@ -2,6 +2,8 @@
 #include <sstream>
 #include <string>
 
+#include "util/stats.hpp"
+
 #include "arraytype.hpp"
 
 namespace abc {
@@ -33,7 +35,11 @@ ArrayType::create(const Type *refType, std::size_t dim, bool constFlag)
     std::stringstream ss;
     ss << "array " << getArrayDimAndType(refType, dim);
     auto ty = ArrayType{refType, dim, constFlag, UStr::create(ss.str())};
-    return &*arraySet.insert(ty).first;
+    auto inserted = arraySet.insert(ty);
+    if (inserted.second) {
+	stats::count(stats::TYPES_ARRAY);
+    }
+    return &*inserted.first;
 }
 
 void
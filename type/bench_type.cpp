@@ -0,0 +1,105 @@
+#include <random>
+#include <vector>
+
+#include "util/bench.hpp"
+
+#include "arraytype.hpp"
+#include "floattype.hpp"
+#include "functiontype.hpp"
+#include "inittypesystem.hpp"
+#include "integertype.hpp"
+#include "pointertype.hpp"
+
+// mix of scalar, pointer and array types
+static std::vector<const abc::Type *>
+randomTypes(std::mt19937_64 &rng, std::size_t num)
+{
+    using namespace abc;
+
+    std::uniform_int_distribution<int> kind(0, 5);
+    std::uniform_int_distribution<std::size_t> dim(1, 64);
+
+    std::vector<const Type *> ty;
+    for (std::size_t i = 0; i < num; ++i) {
+	switch (kind(rng)) {
+	case 0:
+	    ty.push_back(IntegerType::createSigned(8 << (i % 4)));
+	    break;
+	case 1:
+	    ty.push_back(IntegerType::createUnsigned(8 << (i % 4)));
+	    break;
+	case 2:
+	    ty.push_back(FloatType::createDouble());
+	    break;
+	case 3:
+	    ty.push_back(PointerType::create(IntegerType::createChar()));
+	    break;
+	case 4:
+	    ty.push_back(ArrayType::create(IntegerType::createInt(), dim(rng)));
+	    break;
+	default:
+	    ty.push_back(FloatType::createFloat());
+	}
+    }
+    return ty;
+}
+
+int
+main(int argc, char *argv[])
+{
+    using namespace abc;
+
+    bench::init(argc, argv);
+    std::mt19937_64 rng{bench::config.seed};
+    initTypeSystem();
+
+    constexpr std::size_t num = 4096;
+
+    std::uniform_int_distribution<std::size_t> numBits(0, 3);
+    std::vector<std::size_t> bits;
+    std::vector<std::size_t> dim;
+    for (std::size_t i = 0; i < num; ++i) {
+	bits.push_back(8 << numBits(rng));
+	dim.push_back(1 + rng() % 1024);
+    }
+    auto ty = randomTypes(rng, num);
+    auto ty2 = randomTypes(rng, num);
+
+    bench::run("IntegerType::create", num, [&] {
+	for (auto n : bits) {
+	    bench::doNotOptimize(IntegerType::createSigned(n));
+	}
+    });
+
+    bench::run("ArrayType::create hit", num, [&] {
+	auto elemTy = IntegerType::createInt();
+	for (auto n : dim) {
+	    bench::doNotOptimize(ArrayType::create(elemTy, n));
+	}
+    });
+
+    bench::run("FunctionType::create", num, [&] {
+	for (std::size_t i = 0; i + 2 < num; ++i) {
+	    bench::doNotOptimize(
+	        FunctionType::create(ty[i], {ty[i + 1], ty[i + 2]}));
+	}
+    });
+
+    bench::run("Type::convert", num, [&] {
+	for (std::size_t i = 0; i < num; ++i) {
+	    bench::doNotOptimize(Type::convert(ty[i], ty2[i]));
+	}
+    });
+
+    // last: re-initializing the type system invalidates 'ty' and 'ty2'
+    bench::run(
+        "ArrayType::create miss", num, [] { initTypeSystem(); },
+        [&] {
+	    auto elemTy = IntegerType::createInt();
+	    for (auto n : dim) {
+		bench::doNotOptimize(ArrayType::create(elemTy, n));
+	    }
+        });
+
+    bench::report("type");
+}
@@ -1,6 +1,8 @@
 #include <cassert>
 #include <unordered_map>
 
+#include "util/stats.hpp"
+
 #include "enumtype.hpp"
 
 namespace abc {
@@ -29,6 +31,7 @@ EnumType::createIncomplete(UStr name, const Type *intType)
     static std::size_t count;
     auto id = count++;
 
+    stats::count(stats::TYPES_ENUM);
     enumMap.emplace(id, EnumType{id, name, intType, false});
     enumConstMap.emplace(id, EnumType{id, name, intType, true});
 
@@ -0,0 +1,102 @@
+#include <set>
+#include <sstream>
+#include <tuple>
+
+#include "util/stats.hpp"
+
+#include "fixedtype.hpp"
+
+namespace abc {
+
+bool
+operator<(const FixedType &x, const FixedType &y)
+{
+    const auto &tx =
+        std::tuple{x.signedFlag, x.intBits, x.fracBits, x.hasConstFlag()};
+    const auto &ty =
+        std::tuple{y.signedFlag, y.intBits, y.fracBits, y.hasConstFlag()};
+    return tx < ty;
+}
+
+static std::set<FixedType> fixedSet;
+
+//------------------------------------------------------------------------------
+
+FixedType::FixedType(bool signedFlag, std::size_t intBits,
+                     std::size_t fracBits, bool constFlag, UStr name)
+    : Type{constFlag, name}, signedFlag{signedFlag}, intBits{intBits},
+      fracBits{fracBits}
+{
+}
+
+const Type *
+FixedType::create(bool signedFlag, std::size_t intBits, std::size_t fracBits,
+                  bool constFlag)
+{
+    std::stringstream ss;
+    ss << (signedFlag ? "fixed" : "ufixed") << "[" << intBits << ", "
+       << fracBits << "]";
+    auto ty = FixedType{signedFlag, intBits, fracBits, constFlag,
+                        UStr::create(ss.str())};
+    auto inserted = fixedSet.insert(ty);
+    if (inserted.second) {
+	stats::count(stats::TYPES_FIXED);
+    }
+    return &*inserted.first;
+}
+
+void
+FixedType::init()
+{
+    fixedSet.clear();
+}
+
+const Type *
+FixedType::createSigned(std::size_t intBits, std::size_t fracBits)
+{
+    return create(true, intBits, fracBits, false);
+}
+
+const Type *
+FixedType::createUnsigned(std::size_t intBits, std::size_t fracBits)
+{
+    return create(false, intBits, fracBits, false);
+}
+
+const Type *
+FixedType::getConst() const
+{
+    return create(signedFlag, intBits, fracBits, true);
+}
+
+const Type *
+FixedType::getConstRemoved() const
+{
+    return create(signedFlag, intBits, fracBits, false);
+}
+
+std::size_t
+FixedType::numBits() const
+{
+    return intBits + fracBits;
+}
+
+bool
+FixedType::isFixedPoint() const
+{
+    return true;
+}
+
+bool
+FixedType::isSignedFixedPoint() const
+{
+    return signedFlag;
+}
+
+std::size_t
+FixedType::fractionBits() const
+{
+    return fracBits;
+}
+
+} // namespace abc
@@ -0,0 +1,43 @@
+#ifndef TYPE_FIXEDTYPE_HPP
+#define TYPE_FIXEDTYPE_HPP
+
+#include "type.hpp"
+
+namespace abc {
+
+// 'fixed[I, F]' and 'ufixed[I, F]': a value x is stored as the integer
+// x * 2^F with I + F bits. For 'fixed' the I integer bits include the sign
+// bit.
+class FixedType : public Type
+{
+    protected:
+	FixedType(bool signedFlag, std::size_t intBits, std::size_t fracBits,
+	          bool constFlag, UStr name);
+	const bool signedFlag;
+	const std::size_t intBits, fracBits;
+
+	static const Type *create(bool signedFlag, std::size_t intBits,
+	                          std::size_t fracBits, bool constFlag);
+
+    public:
+	static void init();
+	static const Type *createSigned(std::size_t intBits,
+	                                std::size_t fracBits);
+	static const Type *createUnsigned(std::size_t intBits,
+	                                  std::size_t fracBits);
+
+	const Type *getConst() const override;
+	const Type *getConstRemoved() const override;
+
+	std::size_t numBits() const override;
+
+	bool isFixedPoint() const override;
+	bool isSignedFixedPoint() const override;
+	std::size_t fractionBits() const override;
+
+	friend bool operator<(const FixedType &x, const FixedType &y);
+};
+
+} // namespace abc
+
+#endif // TYPE_FIXEDTYPE_HPP
@@ -1,6 +1,8 @@
 #include <set>
 #include <tuple>
 
+#include "util/stats.hpp"
+
 #include "floattype.hpp"
 
 namespace abc {
@@ -27,7 +29,11 @@ FloatType::create(FloatKind floatKind, bool constFlag)
 {
     std::string str = floatKind == FLOAT_KIND ? "float" : "double";
     auto ty = FloatType{floatKind, constFlag, UStr::create(str)};
-    return &*fltSet.insert(ty).first;
+    auto inserted = fltSet.insert(ty);
+    if (inserted.second) {
+	stats::count(stats::TYPES_FLOAT);
+    }
+    return &*inserted.first;
 }
 
 void
@@ -1,6 +1,8 @@
 #include <set>
 #include <sstream>
 
+#include "util/stats.hpp"
+
 #include "functiontype.hpp"
 
 namespace abc {
@@ -9,9 +11,9 @@ bool
 operator<(const FunctionType &x, const FunctionType &y)
 {
     const auto &tx = std::tuple{x.retType(), x.ustr().c_str(), x.paramType(),
-                                x.hasConstFlag()};
+                                x.paramIn(), x.hasConstFlag()};
     const auto &ty = std::tuple{y.retType(), y.ustr().c_str(), y.paramType(),
-                                y.hasConstFlag()};
+                                y.paramIn(), y.hasConstFlag()};
     return tx < ty;
 }
 
@@ -20,17 +22,26 @@ static std::set<FunctionType> fnSet;
 //------------------------------------------------------------------------------
 
 FunctionType::FunctionType(const Type *ret, std::vector<const Type *> &&param,
-                           bool varg, bool constFlag, UStr name)
-    : Type{constFlag, name}, ret{ret}, param{std::move(param)}, varg{varg}
+                           std::vector<bool> &&in, bool varg, bool constFlag,
+                           UStr name)
+    : Type{constFlag, name}, ret{ret}, param{std::move(param)},
+      in{std::move(in)}, varg{varg}
 {
+    this->in.resize(this->param.size(), false);
 }
 
 const Type *
 FunctionType::create(const Type *ret, std::vector<const Type *> &&param,
-                     bool varg, bool constFlag, UStr alias)
+                     std::vector<bool> &&in, bool varg, bool constFlag,
+                     UStr alias)
 {
-    auto ty = FunctionType{ret, std::move(param), varg, constFlag, alias};
-    return &*fnSet.insert(ty).first;
+    auto ty = FunctionType{ret,  std::move(param), std::move(in),
+                           varg, constFlag,        alias};
+    auto inserted = fnSet.insert(ty);
+    if (inserted.second) {
+	stats::count(stats::TYPES_FUNCTION);
+    }
+    return &*inserted.first;
 }
 
 void
@@ -43,30 +54,49 @@ const Type *
 FunctionType::create(const Type *ret, std::vector<const Type *> &&param,
                      bool varg)
 {
+    return create(ret, std::move(param), std::vector<bool>{}, varg);
+}
+
+const Type *
+FunctionType::create(const Type *ret, std::vector<const Type *> &&param,
+                     std::vector<bool> &&in, bool varg)
+{
+    in.resize(param.size(), false);
+
     std::stringstream ss;
     ss << "fn (";
     for (std::size_t i = 0; i < param.size(); ++i) {
-	ss << ":" << param[i];
+	ss << ":";
+	if (in[i]) {
+	    ss << "in " << param[i]->getConstRemoved();
+	} else {
+	    ss << param[i];
+	}
 	if (i + 1 < param.size()) {
 	    ss << ", ";
 	}
     }
     ss << "): " << ret;
-    return create(ret, std::move(param), varg, false, UStr::create(ss.str()));
+    return create(ret, std::move(param), std::move(in), varg, false,
+                  UStr::create(ss.str()));
 }
 
 const Type *
 FunctionType::getConst() const
 {
     std::vector<const Type *> paramTy = paramType();
-    return create(retType(), std::move(paramTy), hasVarg(), true, name);
+    std::vector<bool> paramIn = this->paramIn();
+    return create(retType(), std::move(paramTy), std::move(paramIn),
+                  hasVarg(), true, name);
 }
 
 const Type *
 FunctionType::getConstRemoved() const
 {
     std::vector<const Type *> paramTy = paramType();
-    return create(retType(), std::move(paramTy), hasVarg(), false, name);
+    std::vector<bool> paramIn = this->paramIn();
+    return create(retType(), std::move(paramTy), std::move(paramIn),
+                  hasVarg(), false, name);
 }
 
 bool
@@ -100,4 +130,10 @@ FunctionType::paramType() const
     return param;
 }
 
+const std::vector<bool> &
+FunctionType::paramIn() const
+{
+    return in;
+}
+
 } // namespace abc
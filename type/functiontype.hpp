@@ -11,13 +11,16 @@ class FunctionType : public Type
 {
     protected:
 	FunctionType(const Type *ret, std::vector<const Type *> &&param,
-	             bool varg, bool constFlag, UStr name);
+	             std::vector<bool> &&in, bool varg, bool constFlag,
+	             UStr name);
 	const Type *ret;
 	std::vector<const Type *> param;
+	std::vector<bool> in;
 	bool varg;
 
 	static const Type *create(const Type *ret,
-	                          std::vector<const Type *> &&arg, bool varg,
+	                          std::vector<const Type *> &&arg,
+	                          std::vector<bool> &&in, bool varg,
 	                          bool constFlag, UStr alias);
 
     public:
@@ -25,6 +28,10 @@ class FunctionType : public Type
 	static const Type *create(const Type *ret,
 	                          std::vector<const Type *> &&arg,
 	                          bool varg = false);
+	// 'in[i]' marks parameter 'i' as readonly reference
+	static const Type *create(const Type *ret,
+	                          std::vector<const Type *> &&arg,
+	                          std::vector<bool> &&in, bool varg = false);
 
 	const Type *getConst() const override;
 	const Type *getConstRemoved() const override;
@@ -36,6 +43,7 @@ class FunctionType : public Type
 	const Type *retType() const override;
 	bool hasVarg() const override;
 	const std::vector<const Type *> &paramType() const override;
+	const std::vector<bool> &paramIn() const override;
 };
 
 } // namespace abc
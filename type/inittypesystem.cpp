@@ -1,10 +1,15 @@
 #include "arraytype.hpp"
+#include "autotype.hpp"
 #include "enumtype.hpp"
+#include "fixedtype.hpp"
+#include "floattype.hpp"
 #include "functiontype.hpp"
 #include "inittypesystem.hpp"
 #include "integertype.hpp"
 #include "nullptrtype.hpp"
+#include "packedboolarraytype.hpp"
 #include "pointertype.hpp"
+#include "soaarraytype.hpp"
 #include "structtype.hpp"
 #include "typealias.hpp"
 #include "voidtype.hpp"
@@ -15,11 +20,16 @@ void
 initTypeSystem()
 {
     ArrayType::init();
+    AutoType::init();
     EnumType::init();
+    FixedType::init();
+    FloatType::init();
     FunctionType::init();
     IntegerType::init();
     NullptrType::init();
+    PackedBoolArrayType::init();
     PointerType::init();
+    SoaArrayType::init();
     StructType::init();
     TypeAlias::init();
     VoidType::init();
@@ -2,6 +2,8 @@
 #include <sstream>
 #include <tuple>
 
+#include "util/stats.hpp"
+
 #include "integertype.hpp"
 
 namespace abc {
@@ -19,6 +21,11 @@ operator<(const IntegerType &x, const IntegerType &y)
 
 static std::set<IntegerType> intSet;
 
+// defaults for the host, gen::init sets the ones of the target
+std::size_t IntegerType::intBits = 8 * sizeof(int);
+std::size_t IntegerType::longBits = 8 * sizeof(long);
+std::size_t IntegerType::sizeBits = 8 * sizeof(std::size_t);
+
 //------------------------------------------------------------------------------
 
 IntegerType::IntegerType(std::size_t numBits, bool signed_, bool constFlag,
@@ -33,7 +40,11 @@ IntegerType::create(std::size_t numBits, bool signed_, bool constFlag)
     std::stringstream ss;
     ss << (signed_ ? "i" : "u") << numBits;
     auto ty = IntegerType{numBits, signed_, constFlag, UStr::create(ss.str())};
-    return &*intSet.insert(ty).first;
+    auto inserted = intSet.insert(ty);
+    if (inserted.second) {
+	stats::count(stats::TYPES_INTEGER);
+    }
+    return &*inserted.first;
 }
 
 void
@@ -42,6 +53,15 @@ IntegerType::init()
     intSet.clear();
 }
 
+void
+IntegerType::setTargetWidths(std::size_t intBits_, std::size_t longBits_,
+                             std::size_t sizeBits_)
+{
+    intBits = intBits_;
+    longBits = longBits_;
+    sizeBits = sizeBits_;
+}
+
 const Type *
 IntegerType::createBool()
 {
@@ -57,31 +77,31 @@ IntegerType::createChar()
 const Type *
 IntegerType::createInt()
 {
-    return createSigned(8 * sizeof(int));
+    return createSigned(intBits);
 }
 
 const Type *
 IntegerType::createUnsigned()
 {
-    return createUnsigned(8 * sizeof(unsigned));
+    return createUnsigned(intBits);
 }
 
 const Type *
 IntegerType::createLong()
 {
-    return createSigned(8 * sizeof(long));
+    return createSigned(longBits);
 }
 
 const Type *
 IntegerType::createSizeType()
 {
-    return createSigned(8 * sizeof(std::size_t));
+    return createSigned(sizeBits);
 }
 
 const Type *
 IntegerType::createPtrdiffType()
 {
-    return createSigned(8 * sizeof(std::ptrdiff_t));
+    return createSigned(sizeBits);
 }
 
 const Type *
@@ -16,8 +16,13 @@ class IntegerType : public Type
 	static const Type *create(std::size_t numBits, bool signed_,
 	                          bool constFlag);
 
+	// widths of int, long and size_t on the target
+	static std::size_t intBits, longBits, sizeBits;
+
     public:
 	static void init();
+	static void setTargetWidths(std::size_t intBits, std::size_t longBits,
+	                            std::size_t sizeBits);
 	static const Type *createBool();
 	static const Type *createChar();
 	static const Type *createInt();
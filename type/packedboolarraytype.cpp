@@ -0,0 +1,85 @@
+#include <set>
+#include <sstream>
+#include <string>
+
+#include "util/stats.hpp"
+
+#include "integertype.hpp"
+#include "packedboolarraytype.hpp"
+
+namespace abc {
+
+bool
+operator<(const PackedBoolArrayType &x, const PackedBoolArrayType &y)
+{
+    const auto &tx = std::tuple{x.dim(), x.hasConstFlag()};
+    const auto &ty = std::tuple{y.dim(), y.hasConstFlag()};
+    return tx < ty;
+}
+
+static std::set<PackedBoolArrayType> packedBoolArraySet;
+
+//------------------------------------------------------------------------------
+PackedBoolArrayType::PackedBoolArrayType(std::size_t dim, bool constFlag,
+                                         UStr name)
+    : Type{constFlag, name}, dim_{dim}
+{
+}
+
+const Type *
+PackedBoolArrayType::create(std::size_t dim, bool constFlag)
+{
+    std::stringstream ss;
+    ss << "packed array[" << dim << "] of bool";
+    auto ty = PackedBoolArrayType{dim, constFlag, UStr::create(ss.str())};
+    auto inserted = packedBoolArraySet.insert(ty);
+    if (inserted.second) {
+	stats::count(stats::TYPES_PACKED_BOOL_ARRAY);
+    }
+    return &*inserted.first;
+}
+
+void
+PackedBoolArrayType::init()
+{
+    packedBoolArraySet.clear();
+}
+
+const Type *
+PackedBoolArrayType::create(std::size_t dim)
+{
+    return create(dim, false);
+}
+
+const Type *
+PackedBoolArrayType::getConst() const
+{
+    return create(dim(), true);
+}
+
+const Type *
+PackedBoolArrayType::getConstRemoved() const
+{
+    return create(dim(), false);
+}
+
+bool
+PackedBoolArrayType::isPackedBoolArray() const
+{
+    return true;
+}
+
+const Type *
+PackedBoolArrayType::refType() const
+{
+    auto type = IntegerType::createBool();
+    return hasConstFlag() ? type->getConst() : type;
+}
+
+std::size_t
+PackedBoolArrayType::dim() const
+{
+    return dim_;
+}
+
+} // namespace abc
@@ -0,0 +1,32 @@
+#ifndef TYPE_PACKEDBOOLARRAYTYPE_HPP
+#define TYPE_PACKEDBOOLARRAYTYPE_HPP
+
+#include "type.hpp"
+
+namespace abc {
+
+// An array of bools that uses one bit per element. The bits are stored in
+// words of the size of size_t. An element a[i] has no address.
+class PackedBoolArrayType : public Type
+{
+    private:
+	PackedBoolArrayType(std::size_t dim, bool constFlag, UStr name);
+	const std::size_t dim_;
+
+	static const Type *create(std::size_t dim, bool constFlag);
+
+    public:
+	static void init();
+	static const Type *create(std::size_t dim);
+
+	const Type *getConst() const override;
+	const Type *getConstRemoved() const override;
+
+	bool isPackedBoolArray() const override;
+	const Type *refType() const override;
+	std::size_t dim() const override;
+};
+
+} // namespace abc
+
+#endif // TYPE_PACKEDBOOLARRAYTYPE_HPP
@@ -2,6 +2,8 @@
 #include <sstream>
 #include <tuple>
 
+#include "util/stats.hpp"
+
 #include "pointertype.hpp"
 
 namespace abc {
@@ -31,7 +33,11 @@ PointerType::create(const Type *refType, bool constFlag)
     std::stringstream ss;
     ss << "-> " << refType;
     auto ty = PointerType{refType, constFlag, UStr::create(ss.str())};
-    return &*pointerSet.insert(ty).first;
+    auto inserted = pointerSet.insert(ty);
+    if (inserted.second) {
+	stats::count(stats::TYPES_POINTER);
+    }
+    return &*inserted.first;
 }
 
 void
@@ -0,0 +1,97 @@
+#include <cassert>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include "util/stats.hpp"
+
+#include "soaarraytype.hpp"
+
+namespace abc {
+
+bool
+operator<(const SoaArrayType &x, const SoaArrayType &y)
+{
+    const auto &tx =
+        std::tuple{x.ustr().c_str(), x.refType(), x.dim(), x.hasConstFlag()};
+    const auto &ty =
+        std::tuple{y.ustr().c_str(), y.refType(), y.dim(), y.hasConstFlag()};
+    return tx < ty;
+}
+
+static std::set<SoaArrayType> soaArraySet;
+
+//------------------------------------------------------------------------------
+SoaArrayType::SoaArrayType(const Type *refType, std::size_t dim,
+                           bool constFlag, UStr name)
+    : Type{constFlag, name}, refType_{refType}, dim_{dim}
+{
+}
+
+const Type *
+SoaArrayType::create(const Type *refType, std::size_t dim, bool constFlag)
+{
+    assert(refType->isStruct());
+    std::stringstream ss;
+    ss << "soa array[" << dim << "] of " << refType;
+    auto ty = SoaArrayType{refType, dim, constFlag, UStr::create(ss.str())};
+    auto inserted = soaArraySet.insert(ty);
+    if (inserted.second) {
+	stats::count(stats::TYPES_SOA_ARRAY);
+    }
+    return &*inserted.first;
+}
+
+void
+SoaArrayType::init()
+{
+    soaArraySet.clear();
+}
+
+const Type *
+SoaArrayType::create(const Type *refType, std::size_t dim)
+{
+    return create(refType, dim, false);
+}
+
+const Type *
+SoaArrayType::getConst() const
+{
+    return create(refType_, dim(), true);
+}
+
+const Type *
+SoaArrayType::getConstRemoved() const
+{
+    return create(refType_, dim(), false);
+}
+
+bool
+SoaArrayType::hasSize() const
+{
+    return refType_->hasSize();
+}
+
+bool
+SoaArrayType::isSoaArray() const
+{
+    return true;
+}
+
+const Type *
+SoaArrayType::refType() const
+{
+    if (hasConstFlag()) {
+	return refType_->getConst();
+    } else {
+	return refType_;
+    }
+}
+
+std::size_t
+SoaArrayType::dim() const
+{
+    return dim_;
+}
+
+} // namespace abc
@@ -0,0 +1,38 @@
+#ifndef TYPE_SOAARRAYTYPE_HPP
+#define TYPE_SOAARRAYTYPE_HPP
+
+#include "type.hpp"
+
+namespace abc {
+
+// An array of structs stored as a struct of arrays: for each member of the
+// struct there is one array with 'dim' elements. The element a[i] has no
+// address, only its members a[i].x have one.
+class SoaArrayType : public Type
+{
+    private:
+	SoaArrayType(const Type *refType, std::size_t dim, bool constFlag,
+	             UStr name);
+	const Type *refType_;
+	const std::size_t dim_;
+
+	static const Type *create(const Type *refType, std::size_t dim,
+	                          bool constFlag);
+
+    public:
+	static void init();
+	static const Type *create(const Type *refType, std::size_t dim);
+
+	const Type *getConst() const override;
+	const Type *getConstRemoved() const override;
+
+	bool hasSize() const override;
+
+	bool isSoaArray() const override;
+	const Type *refType() const override;
+	std::size_t dim() const override;
+};
+
+} // namespace abc
+
+#endif // TYPE_SOAARRAYTYPE_HPP
@@ -1,6 +1,8 @@
 #include <cassert>
 #include <unordered_map>
 
+#include "util/stats.hpp"
+
 #include "structtype.hpp"
 
 namespace abc {
@@ -28,6 +30,7 @@ StructType::createIncomplete(UStr name)
     static std::size_t count;
     auto id = count++;
 
+    stats::count(stats::TYPES_STRUCT);
     structSet.emplace(id, StructType{id, name, false});
     structConstSet.emplace(id, StructType{id, name, true});
 
@@ -67,21 +70,42 @@ StructType::isStruct() const
 const Type *
 StructType::complete(std::vector<UStr> &&memberName,
                      std::vector<std::size_t> &&memberIndex,
-                     std::vector<const Type *> &&memberType)
+                     std::vector<const Type *> &&memberType,
+                     std::vector<std::size_t> &&memberBitWidth)
 {
     assert(memberName.size() == memberIndex.size());
     assert(memberName.size() == memberType.size());
+    if (memberBitWidth.empty()) {
+	memberBitWidth.resize(memberName.size());
+    }
+    assert(memberName.size() == memberBitWidth.size());
+
+    // bit-fields with the same member index are packed from the least
+    // significant bit of their storage unit upwards
+    std::vector<std::size_t> memberBitOffset(memberName.size());
+    std::unordered_map<std::size_t, std::size_t> usedBits;
+    for (std::size_t i = 0; i < memberName.size(); ++i) {
+	if (memberBitWidth[i]) {
+	    memberBitOffset[i] = usedBits[memberIndex[i]];
+	    usedBits[memberIndex[i]] += memberBitWidth[i];
+	}
+    }
+
     auto &constStructType = structConstSet.at(id());
     for (std::size_t i = 0; i < memberName.size(); ++i) {
 	constStructType.memberName_.push_back(memberName[i]);
 	constStructType.memberIndex_.push_back(memberIndex[i]);
 	constStructType.memberType_.push_back(memberType[i]->getConst());
     }
+    constStructType.memberBitWidth_ = memberBitWidth;
+    constStructType.memberBitOffset_ = memberBitOffset;
     constStructType.isComplete_ = true;
 
     memberName_ = std::move(memberName);
     memberIndex_ = std::move(memberIndex);
     memberType_ = std::move(memberType);
+    memberBitWidth_ = std::move(memberBitWidth);
+    memberBitOffset_ = std::move(memberBitOffset);
     isComplete_ = true;
     return this;
 }
@@ -115,6 +139,18 @@ StructType::memberType(UStr name) const
     return nullptr;
 }
 
+const std::vector<std::size_t> &
+StructType::memberBitWidth() const
+{
+    return memberBitWidth_;
+}
+
+const std::vector<std::size_t> &
+StructType::memberBitOffset() const
+{
+    return memberBitOffset_;
+}
+
 std::optional<std::size_t>
 StructType::memberIndex(UStr name) const
 {
@@ -3,6 +3,7 @@
 #include <iostream>
 
 #include "arraytype.hpp"
+#include "fixedtype.hpp"
 #include "integertype.hpp"
 #include "pointertype.hpp"
 #include "type.hpp"
@@ -26,6 +27,10 @@ Type::equals(const Type *ty1, const Type *ty2)
     } else if (ty1->isFloatType() && ty2->isFloatType()) {
 	return (ty1->isFloat() && ty2->isFloat()) ||
 	       (ty1->isDouble() && ty2->isDouble());
+    } else if (ty1->isFixedPoint() && ty2->isFixedPoint()) {
+	return ty1->isSignedFixedPoint() == ty2->isSignedFixedPoint() &&
+	       ty1->numBits() == ty2->numBits() &&
+	       ty1->fractionBits() == ty2->fractionBits();
     } else if (ty1->isPointer() && ty2->isPointer()) {
 	if (ty1->isNullptr() || ty2->isNullptr()) {
 	    return ty1->isNullptr() == ty2->isNullptr();
@@ -37,6 +42,11 @@ Type::equals(const Type *ty1, const Type *ty2)
     } else if (ty1->isArray() && ty2->isArray()) {
 	return ty1->dim() == ty2->dim() &&
 	       equals(ty1->refType(), ty2->refType());
+    } else if (ty1->isSoaArray() && ty2->isSoaArray()) {
+	return ty1->dim() == ty2->dim() &&
+	       equals(ty1->refType(), ty2->refType());
+    } else if (ty1->isPackedBoolArray() && ty2->isPackedBoolArray()) {
+	return ty1->dim() == ty2->dim();
     } else if (ty1->isFunction() && ty2->isFunction()) {
 	if (!equals(ty1->retType(), ty2->retType())) {
 	    return false;
@@ -49,6 +59,9 @@ Type::equals(const Type *ty1, const Type *ty2)
 	if (paramType1.size() != paramType2.size()) {
 	    return false;
 	}
+	if (ty1->paramIn() != ty2->paramIn()) {
+	    return false;
+	}
 	for (std::size_t i = 0; i < paramType1.size(); ++i) {
 	    if (!equals(paramType1[i], paramType2[i])) {
 		return false;
@@ -65,8 +78,11 @@ Type::common(const Type *ty1, const Type *ty2)
     assert(ty1);
     assert(ty2);
 
-    // if types are integer and floating point always have float type in ty1
-    if (ty1->isInteger() && ty2->isFloatType()) {
+    // if types are integer and floating point always have float type in ty1,
+    // and the same for fixed-point types
+    if ((ty1->isInteger() || ty1->isFixedPoint()) && ty2->isFloatType()) {
+	std::swap(ty1, ty2);
+    } else if (ty1->isInteger() && ty2->isFixedPoint()) {
 	std::swap(ty1, ty2);
     }
 
@@ -78,8 +94,31 @@ Type::common(const Type *ty1, const Type *ty2)
 	if (equals(ty1->refType(), ty2->refType())) {
 	    common = PointerType::create(ty1->refType());
 	}
-    } else if (ty1->isFloatType() && ty2->isInteger()) {
+    } else if (ty1->isFloatType() &&
+               (ty2->isInteger() || ty2->isFixedPoint())) {
+	common = ty1;
+    } else if (ty1->isFixedPoint() && ty2->isInteger()) {
 	common = ty1;
+    } else if (ty1->isFixedPoint() && ty2->isFixedPoint()) {
+	// keep the larger range and the larger precision. If the result is
+	// signed an unsigned operand needs one more integer bit for the sign.
+	// The size gets rounded up to 8, 16, 32 or 64 bits by adding integer
+	// bits.
+	bool isSigned = ty1->isSignedFixedPoint() || ty2->isSignedFixedPoint();
+	auto rangeBits = [=](const Type *ty) {
+	    auto bits = ty->numBits() - ty->fractionBits();
+	    return isSigned && !ty->isSignedFixedPoint() ? bits + 1 : bits;
+	};
+	auto fracBits = std::max(ty1->fractionBits(), ty2->fractionBits());
+	auto intBits = std::max(rangeBits(ty1), rangeBits(ty2));
+	for (std::size_t size : {8, 16, 32, 64}) {
+	    if (intBits + fracBits <= size) {
+		intBits = size - fracBits;
+		common = isSigned ? FixedType::createSigned(intBits, fracBits)
+		                  : FixedType::createUnsigned(intBits, fracBits);
+		break;
+	    }
+	}
     } else if (ty1->isInteger() && ty2->isInteger()) {
 	auto size = std::max(ty1->numBits(), ty2->numBits());
 	if (ty1->isUnsignedInteger() || ty2->isUnsignedInteger()) {
@@ -126,14 +165,14 @@ convert(const Type *from, const Type *to, bool checkConst)
 	} else {
 	    return nullptr;
 	}
-    } else if (to->isFloatType()) {
-	if (from->isInteger() || from->isFloatType()) {
+    } else if (to->isFloatType() || to->isFixedPoint()) {
+	if (from->isInteger() || from->isFloatType() || from->isFixedPoint()) {
 	    return to;
 	} else {
 	    return nullptr;
 	}
     } else if (to->isInteger()) {
-	if (from->isInteger() || from->isFloatType()) {
+	if (from->isInteger() || from->isFloatType() || from->isFixedPoint()) {
 	    return to;
 	} else {
 	    return nullptr;
@@ -227,7 +266,7 @@ Type::hasConstFlag() const
 bool
 Type::isScalar() const
 {
-    return !isArray() && !isStruct();
+    return !isArray() && !isStruct() && !isSoaArray() && !isPackedBoolArray();
 }
 
 std::size_t
@@ -359,6 +398,25 @@ Type::isDouble() const
     return isAlias() ? getUnalias()->isDouble() : false;
 }
 
+// for fixed-point (sub-)types
+bool
+Type::isFixedPoint() const
+{
+    return isAlias() ? getUnalias()->isFixedPoint() : false;
+}
+
+bool
+Type::isSignedFixedPoint() const
+{
+    return isAlias() ? getUnalias()->isSignedFixedPoint() : false;
+}
+
+std::size_t
+Type::fractionBits() const
+{
+    return isAlias() ? getUnalias()->fractionBits() : 0;
+}
+
 // for pointer and array (sub-)types
 bool
 Type::isPointer() const
@@ -381,6 +439,12 @@ Type::isUnboundArray() const
     return false;
 }
 
+bool
+Type::isSoaArray() const
+{
+    return isAlias() ? getUnalias()->isSoaArray() : false;
+}
+
 const Type *
 Type::refType() const
 {
@@ -430,6 +494,13 @@ Type::paramType() const
     return isAlias() ? getUnalias()->paramType() : noArgs;
 }
 
+const std::vector<bool> &
+Type::paramIn() const
+{
+    static std::vector<bool> noArgs;
+    return isAlias() ? getUnalias()->paramIn() : noArgs;
+}
+
 // for enum (sub-)types
 bool
 Type::isEnum() const
@@ -456,7 +527,7 @@ Type::isStruct() const
 
 const Type *
 Type::complete(std::vector<UStr> &&, std::vector<std::size_t> &&,
-               std::vector<const Type *> &&)
+               std::vector<const Type *> &&, std::vector<std::size_t> &&)
 {
     if (isAlias() && getUnalias()->isStruct()) {
 	assert(0 && "Alias type can not be completed");
@@ -498,6 +569,35 @@ Type::memberType(UStr name) const
     return isAlias() ? getUnalias()->memberType(name) : nullptr;
 }
 
+const std::vector<std::size_t> &
+Type::memberBitWidth() const
+{
+    static std::vector<std::size_t> noMembers;
+    return isAlias() ? getUnalias()->memberBitWidth() : noMembers;
+}
+
+const std::vector<std::size_t> &
+Type::memberBitOffset() const
+{
+    static std::vector<std::size_t> noMembers;
+    return isAlias() ? getUnalias()->memberBitOffset() : noMembers;
+}
+
+bool
+Type::hasBitFields() const
+{
+    const auto &width = memberBitWidth();
+    return std::any_of(width.begin(), width.end(),
+                       [](std::size_t w) { return w > 0; });
+}
+
+// for packed bool arrays
+bool
+Type::isPackedBoolArray() const
+{
+    return isAlias() ? getUnalias()->isPackedBoolArray() : false;
+}
+
 std::ostream &
 operator<<(std::ostream &out, const Type *type)
 {
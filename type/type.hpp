@@ -64,10 +64,16 @@ class Type
 	virtual bool isFloat() const;
 	virtual bool isDouble() const;
 
+	// for fixed-point (sub-)types, numBits() is the total number of bits
+	virtual bool isFixedPoint() const;
+	virtual bool isSignedFixedPoint() const;
+	virtual std::size_t fractionBits() const;
+
 	// for pointer and array (sub-)types
 	virtual bool isPointer() const;
 	virtual bool isArray() const;
 	bool isUnboundArray() const;
+	virtual bool isSoaArray() const;
 	virtual const Type *refType() const;
 	virtual std::size_t dim() const;
 	static const Type *patchUnboundArray(const Type *type, std::size_t dim);
@@ -76,6 +82,7 @@ class Type
 	virtual bool isFunction() const;
 	virtual const Type *retType() const;
 	virtual const std::vector<const Type *> &paramType() const;
+	virtual const std::vector<bool> &paramIn() const;
 	virtual bool hasVarg() const;
 
 	// for enum (sub-)types
@@ -87,12 +94,21 @@ class Type
 	virtual bool isStruct() const;
 	virtual const Type *complete(std::vector<UStr> &&memberName,
 	                             std::vector<std::size_t> &&memberIndex,
-	                             std::vector<const Type *> &&memberType);
+	                             std::vector<const Type *> &&memberType,
+	                             std::vector<std::size_t> &&memberBitWidth);
 	virtual const std::vector<UStr> &memberName() const;
 	virtual const std::vector<std::size_t> &memberIndex() const;
 	virtual std::optional<std::size_t> memberIndex(UStr name) const;
 	virtual const std::vector<const Type *> &memberType() const;
 	virtual const Type *memberType(UStr name) const;
+	// bit-fields share the member index of their storage unit, a width of 0
+	// means the member is no bit-field
+	virtual const std::vector<std::size_t> &memberBitWidth() const;
+	virtual const std::vector<std::size_t> &memberBitOffset() const;
+	bool hasBitFields() const;
+
+	// for packed bool arrays
+	virtual bool isPackedBoolArray() const;
 
 	friend std::ostream &operator<<(std::ostream &out, const Type *type);
 };
@@ -1,5 +1,7 @@
 #include <iostream>
 
+#include "util/stats.hpp"
+
 #include "typealias.hpp"
 
 namespace abc {
@@ -28,6 +30,7 @@ TypeAlias::create(UStr name, const Type *type)
     static std::size_t count;
     auto id = count++;
 
+    stats::count(stats::TYPES_ALIAS);
     aliasSet.emplace(id, TypeAlias{id, name, type, false});
     aliasConstSet.emplace(id, TypeAlias{id, name, type, true});
 
@@ -0,0 +1,235 @@
+#ifndef UTIL_BENCH_HPP
+#define UTIL_BENCH_HPP
+
+//
+// Tiny harness for the bench_* programs (built and run by 'make bench').
+//
+// Each benchmark runs 'warmup' untimed and 'reps' timed repetitions of a
+// workload with 'ops' operations. We report the median ns/op and the number
+// of global operator new calls per op as JSON on stdout.
+//
+// This header replaces the global operator new/delete (including the array
+// and aligned forms). Include it from exactly one translation unit per program.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+inline std::size_t allocCount;
+
+struct Result
+{
+	std::string name;
+	std::size_t ops;
+	double nsPerOp;
+	double allocsPerOp;
+};
+
+struct Config
+{
+	std::uint64_t seed = 42;
+	std::size_t warmup = 2;
+	std::size_t reps = 10;
+};
+
+inline Config config;
+inline std::vector<Result> result;
+
+// usage: bench_xxx [ -s seed ] [ -w warmup ] [ -r reps ]
+inline void
+init(int argc, char *argv[])
+{
+    for (int i = 1; i + 1 < argc; i += 2) {
+	auto val = std::strtoull(argv[i + 1], nullptr, 10);
+	if (argv[i] == std::string{"-s"}) {
+	    config.seed = val;
+	} else if (argv[i] == std::string{"-w"}) {
+	    config.warmup = val;
+	} else if (argv[i] == std::string{"-r"} && val > 0) {
+	    config.reps = val;
+	} else {
+	    std::cerr << "usage: " << argv[0]
+	              << " [ -s seed ] [ -w warmup ] [ -r reps ]\n";
+	    std::exit(1);
+	}
+    }
+}
+
+// 'setup' is called (untimed) before each repetition of 'body'
+inline void
+run(const char *name, std::size_t ops, std::function<void()> setup,
+    std::function<void()> body)
+{
+    using Clock = std::chrono::steady_clock;
+
+    for (std::size_t i = 0; i < config.warmup; ++i) {
+	setup();
+	body();
+    }
+
+    std::vector<double> ns;
+    std::vector<std::size_t> allocs;
+    for (std::size_t i = 0; i < config.reps; ++i) {
+	setup();
+	auto allocStart = allocCount;
+	auto start = Clock::now();
+	body();
+	auto stop = Clock::now();
+	allocs.push_back(allocCount - allocStart);
+	ns.push_back(
+	    std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+    std::sort(ns.begin(), ns.end());
+    std::sort(allocs.begin(), allocs.end());
+
+    ops = std::max(ops, std::size_t{1});
+    result.push_back({name, ops, ns[ns.size() / 2] / ops,
+                      double(allocs[allocs.size() / 2]) / ops});
+}
+
+inline void
+run(const char *name, std::size_t ops, std::function<void()> body)
+{
+    run(name, ops, [] {}, body);
+}
+
+inline void
+report(const char *component)
+{
+    auto &out = std::cout;
+    out << "{\n"
+        << "  \"component\": \"" << component << "\",\n"
+        << "  \"seed\": " << config.seed << ",\n"
+        << "  \"warmup\": " << config.warmup << ",\n"
+        << "  \"reps\": " << config.reps << ",\n"
+        << "  \"results\": [\n";
+    for (std::size_t i = 0; i < result.size(); ++i) {
+	const auto &r = result[i];
+	out << "    { \"name\": \"" << r.name << "\", \"ops\": " << r.ops
+	    << ", \"ns_per_op\": " << r.nsPerOp
+	    << ", \"allocs_per_op\": " << r.allocsPerOp << " }"
+	    << (i + 1 < result.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n"
+        << "}\n";
+}
+
+// keep the optimizer from discarding results
+template <typename T>
+inline void
+doNotOptimize(const T &val)
+{
+    asm volatile("" : : "r,m"(val) : "memory");
+}
+
+} // namespace bench
+
+namespace bench {
+
+inline void *
+alloc(std::size_t size)
+{
+    ++allocCount;
+    if (auto p = std::malloc(size ? size : 1)) {
+	return p;
+    }
+    throw std::bad_alloc{};
+}
+
+// aligned_alloc() requires the size to be a multiple of the alignment
+inline void *
+alloc(std::size_t size, std::align_val_t align)
+{
+    ++allocCount;
+    auto a = static_cast<std::size_t>(align);
+    size = size ? (size + a - 1) / a * a : a;
+    if (auto p = std::aligned_alloc(a, size)) {
+	return p;
+    }
+    throw std::bad_alloc{};
+}
+
+} // namespace bench
+
+void *
+operator new(std::size_t size)
+{
+    return bench::alloc(size);
+}
+
+void *
+operator new[](std::size_t size)
+{
+    return bench::alloc(size);
+}
+
+void *
+operator new(std::size_t size, std::align_val_t align)
+{
+    return bench::alloc(size, align);
+}
+
+void *
+operator new[](std::size_t size, std::align_val_t align)
+{
+    return bench::alloc(size, align);
+}
+
+void
+operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void *p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void *p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void *p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void *p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+#endif // UTIL_BENCH_HPP
@@ -0,0 +1,56 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "ustr.hpp"
+
+static std::vector<std::string>
+randomNames(std::mt19937_64 &rng, std::size_t num)
+{
+    std::uniform_int_distribution<std::size_t> len(1, 16);
+    std::uniform_int_distribution<int> ch('a', 'z');
+
+    std::vector<std::string> name;
+    for (std::size_t i = 0; i < num; ++i) {
+	std::string s;
+	for (auto n = len(rng); n--;) {
+	    s += char(ch(rng));
+	}
+	name.push_back(s + std::to_string(i));
+    }
+    return name;
+}
+
+int
+main(int argc, char *argv[])
+{
+    using namespace abc;
+
+    bench::init(argc, argv);
+    std::mt19937_64 rng{bench::config.seed};
+
+    auto name = randomNames(rng, 8192);
+
+    bench::run(
+        "UStr::create(std::string) miss", name.size(), [] { UStr::init(); },
+        [&] {
+	    for (const auto &s : name) {
+		bench::doNotOptimize(UStr::create(s));
+	    }
+        });
+
+    bench::run("UStr::create(std::string) hit", name.size(), [&] {
+	for (const auto &s : name) {
+	    bench::doNotOptimize(UStr::create(s));
+	}
+    });
+
+    bench::run("UStr::create(const char *) hit", name.size(), [&] {
+	for (const auto &s : name) {
+	    bench::doNotOptimize(UStr::create(s.c_str()));
+	}
+    });
+
+    bench::report("ustr");
+}
@@ -0,0 +1,49 @@
+#include <iomanip>
+
+#include "json.hpp"
+
+namespace abc {
+
+void
+printJsonString(std::ostream &out, std::string_view s)
+{
+    out << '"';
+    for (unsigned char c : s) {
+	switch (c) {
+	case '"':
+	    out << "\\\"";
+	    break;
+	case '\\':
+	    out << "\\\\";
+	    break;
+	case '\b':
+	    out << "\\b";
+	    break;
+	case '\f':
+	    out << "\\f";
+	    break;
+	case '\n':
+	    out << "\\n";
+	    break;
+	case '\r':
+	    out << "\\r";
+	    break;
+	case '\t':
+	    out << "\\t";
+	    break;
+	default:
+	    if (c < 0x20) {
+		auto flags = out.flags();
+		auto fill = out.fill('0');
+		out << "\\u" << std::hex << std::setw(4) << unsigned{c};
+		out.flags(flags);
+		out.fill(fill);
+	    } else {
+		out << c;
+	    }
+	}
+    }
+    out << '"';
+}
+
+} // namespace abc
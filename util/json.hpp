@@ -0,0 +1,15 @@
+#ifndef UTIL_JSON_HPP
+#define UTIL_JSON_HPP
+
+#include <ostream>
+#include <string_view>
+
+namespace abc {
+
+// print s as a quoted JSON string, i.e. with '"', '\' and control characters
+// escaped
+void printJsonString(std::ostream &out, std::string_view s);
+
+} // namespace abc
+
+#endif // UTIL_JSON_HPP
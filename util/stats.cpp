@@ -0,0 +1,40 @@
+#include <iomanip>
+
+#include "stats.hpp"
+
+namespace abc {
+namespace stats {
+
+std::uint64_t counter[NUM_COUNTERS];
+
+static const char *counterName[NUM_COUNTERS] = {
+    "tokens",                  "macro_expansions", "includes",
+    "ustr_interned",           "symtab_lookups",   "symtab_probes",
+    "types_integer",           "types_float",      "types_fixed",
+    "types_pointer",           "types_array",      "types_soa_array",
+    "types_packed_bool_array", "types_function",   "types_struct",
+    "types_enum",              "types_alias",      "expr_nodes",
+    "ast_nodes",               "apply_visits",     "constant_folds",
+};
+
+void
+reset()
+{
+    for (auto &c : counter) {
+	c = 0;
+    }
+}
+
+void
+print(std::ostream &out, int indent)
+{
+    out << "{\n";
+    for (std::size_t i = 0; i < NUM_COUNTERS; ++i) {
+	out << std::setw(indent + 2) << ' ' << "\"" << counterName[i]
+	    << "\": " << counter[i] << (i + 1 < NUM_COUNTERS ? ",\n" : "\n");
+    }
+    out << std::setw(indent) << "" << "}";
+}
+
+} // namespace stats
+} // namespace abc
@@ -0,0 +1,68 @@
+#ifndef UTIL_STATS_HPP
+#define UTIL_STATS_HPP
+
+#include <cstdint>
+#include <ostream>
+
+//
+// Counters that explain the compile cost of an input (-fstats). Counting is
+// a plain increment and always enabled; the driver resets the counters for
+// each input file.
+//
+
+namespace abc {
+namespace stats {
+
+enum Counter
+{
+    // lexer
+    TOKENS,
+    MACRO_EXPANSIONS,
+    INCLUDES,
+    USTR_INTERNED,
+
+    // symbol table
+    SYMTAB_LOOKUPS,
+    SYMTAB_PROBES,
+
+    // type system: types created per kind
+    TYPES_INTEGER,
+    TYPES_FLOAT,
+    TYPES_FIXED,
+    TYPES_POINTER,
+    TYPES_ARRAY,
+    TYPES_SOA_ARRAY,
+    TYPES_PACKED_BOOL_ARRAY,
+    TYPES_FUNCTION,
+    TYPES_STRUCT,
+    TYPES_ENUM,
+    TYPES_ALIAS,
+
+    // AST
+    EXPR_NODES,
+    AST_NODES,
+    APPLY_VISITS,
+
+    // code generation
+    CONSTANT_FOLDS,
+
+    NUM_COUNTERS,
+};
+
+extern std::uint64_t counter[NUM_COUNTERS];
+
+inline void
+count(Counter c, std::uint64_t n = 1)
+{
+    counter[c] += n;
+}
+
+void reset();
+
+// print all counters as members of a JSON object
+void print(std::ostream &out, int indent = 0);
+
+} // namespace stats
+} // namespace abc
+
+#endif // UTIL_STATS_HPP
@@ -1,5 +1,6 @@
 #include <set>
 
+#include "stats.hpp"
 #include "ustr.hpp"
 
 namespace abc {
@@ -8,9 +9,13 @@ static std::set<std::string> ustrSet;
 
 UStr::UStr() : c_str_{nullptr}, len{0} {}
 
-UStr::UStr(const std::string &s)
-    : c_str_{ustrSet.insert(s).first->c_str()}, len{s.length()}
+UStr::UStr(const std::string &s) : len{s.length()}
 {
+    auto inserted = ustrSet.insert(s);
+    if (inserted.second) {
+	stats::count(stats::USTR_INTERNED);
+    }
+    c_str_ = inserted.first->c_str();
 }
 
 void
@@ -0,0 +1,241 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+
+//
+// Generates a synthetic ABC program for compile-time benchmarks. The program
+// is written to '<dir>/prog.abc', headers to '<dir>/prog_inc<K>.hdr' (compile
+// with '-I <dir>').
+//
+
+struct Param
+{
+	std::size_t numFn = 100;       // number of functions
+	std::size_t depth = 4;         // nesting depth of control structures
+	std::size_t exprLen = 8;       // number of operands in expression chains
+	std::size_t structWidth = 16;  // number of struct members
+	std::size_t initSize = 256;    // number of elements of global initializer
+	std::size_t numInclude = 4;    // number of included headers
+	std::size_t numMacro = 16;     // number of (chained) macros
+	std::uint64_t seed = 42;
+};
+
+void
+usage(const char *prog)
+{
+    std::cerr << "usage: " << prog
+              << " [ -f numFn ] [ -d depth ] [ -e exprLen ] "
+              << "[ -w structWidth ] [ -i initSize ] [ -n numInclude ] "
+              << "[ -m numMacro ] [ -s seed ] dir" << std::endl;
+    std::exit(1);
+}
+
+void
+genHeader(std::ostream &out, std::size_t k, const Param &param)
+{
+    out << "// generated header " << k << "\n\n";
+    out << "extern fn ext" << k << "(a: int, b: -> const char): int;\n";
+    out << "extern global" << k << ": array[" << param.initSize
+        << "] of long;\n";
+    out << "@define INC" << k << "_VAL " << k << "\n";
+}
+
+void
+genProgram(std::ostream &out, const Param &param, std::mt19937_64 &rng)
+{
+    std::uniform_int_distribution<int> val(1, 999);
+    const char *op[] = {"+", "-", "*", "^", "|", "&"};
+    std::uniform_int_distribution<std::size_t> opIdx(0, std::size(op) - 1);
+
+    out << "// generated program: numFn=" << param.numFn
+        << ", depth=" << param.depth << ", exprLen=" << param.exprLen
+        << ", structWidth=" << param.structWidth
+        << ", initSize=" << param.initSize
+        << ", numInclude=" << param.numInclude
+        << ", numMacro=" << param.numMacro << ", seed=" << param.seed
+        << "\n\n";
+
+    for (std::size_t k = 0; k < param.numInclude; ++k) {
+	out << "@ <prog_inc" << k << ".hdr>\n";
+    }
+    out << "\n";
+
+    // chained macros: M<k> expands M<k-1>
+    out << "@define M0 1\n";
+    for (std::size_t k = 1; k < param.numMacro; ++k) {
+	out << "@define M" << k << " (M" << k - 1 << " + " << val(rng)
+	    << ")\n";
+    }
+    out << "\n";
+
+    out << "struct Wide\n{\n";
+    for (std::size_t k = 0; k < param.structWidth; ++k) {
+	switch (k % 3) {
+	case 0:
+	    out << "    m" << k << ": int;\n";
+	    break;
+	case 1:
+	    out << "    m" << k << ": double;\n";
+	    break;
+	default:
+	    out << "    m" << k << ": array[4] of u8;\n";
+	}
+    }
+    out << "};\n\n";
+
+    out << "global table: array[" << param.initSize << "] of int = {";
+    for (std::size_t k = 0; k < param.initSize; ++k) {
+	out << (k % 16 ? " " : "\n    ") << val(rng) << ",";
+    }
+    out << "\n};\n\n";
+
+    out << "fn initWide(w: -> Wide, v: int)\n{\n";
+    for (std::size_t k = 0; k < param.structWidth; ++k) {
+	switch (k % 3) {
+	case 0:
+	case 1:
+	    out << "    w->m" << k << " = v + " << k << ";\n";
+	    break;
+	default:
+	    out << "    w->m" << k << "[" << k % 4 << "] = v;\n";
+	}
+    }
+    out << "}\n\n";
+
+    for (std::size_t f = 0; f < param.numFn; ++f) {
+	out << "fn f" << f << "(a: int, b: int): int\n{\n";
+	out << "    local x: int = a;\n";
+	out << "    local w: Wide;\n";
+	out << "    initWide(&w, b);\n";
+
+	std::string indent = "    ";
+	for (std::size_t d = 0; d < param.depth; ++d) {
+	    switch (d % 3) {
+	    case 0:
+		out << indent << "if (x > " << val(rng) << ") {\n";
+		break;
+	    case 1:
+		// not 'i': i8, i16, ... are type names
+		out << indent << "for (local k" << d << ": int = 0; k" << d
+		    << " < " << d + 2 << "; ++k" << d << ") {\n";
+		break;
+	    default:
+		out << indent << "while (x < " << val(rng) << ") {\n";
+	    }
+	    indent += "    ";
+	    if (d % 3 == 2) {
+		out << indent << "++x;\n";
+	    }
+	}
+
+	out << indent << "x = a";
+	for (std::size_t e = 0; e < param.exprLen; ++e) {
+	    out << " " << op[opIdx(rng)] << " ";
+	    switch (e % 4) {
+	    case 0:
+		out << "b";
+		break;
+	    case 1:
+		out << "table[" << val(rng) % param.initSize << "]";
+		break;
+	    case 2:
+		out << "w.m0";
+		break;
+	    default:
+		out << val(rng);
+	    }
+	}
+	out << ";\n";
+
+	for (std::size_t d = param.depth; d-- > 0;) {
+	    indent.resize(indent.size() - 4);
+	    out << indent << "}\n";
+	}
+	if (param.numMacro) {
+	    out << "    x += M" << f % param.numMacro << ";\n";
+	}
+	if (param.numInclude) {
+	    out << "    x += INC" << f % param.numInclude << "_VAL;\n";
+	}
+	if (f > 0) {
+	    out << "    x += f" << f - 1 << "(x, b);\n";
+	}
+	out << "    return x;\n}\n\n";
+    }
+
+    out << "fn main(): int\n{\n";
+    out << "    return "
+        << (param.numFn ? "f" + std::to_string(param.numFn - 1) + "(1, 2)"
+                        : "0")
+        << ";\n}\n";
+}
+
+int
+main(int argc, char *argv[])
+{
+    Param param;
+    std::filesystem::path dir;
+
+    for (int i = 1; i < argc; ++i) {
+	if (argv[i][0] == '-' && argv[i][1] && !argv[i][2] && i + 1 < argc) {
+	    auto val = std::strtoull(argv[++i], nullptr, 10);
+	    switch (argv[i - 1][1]) {
+	    case 'f':
+		param.numFn = val;
+		break;
+	    case 'd':
+		param.depth = val;
+		break;
+	    case 'e':
+		param.exprLen = val;
+		break;
+	    case 'w':
+		param.structWidth = val ? val : 1;
+		break;
+	    case 'i':
+		param.initSize = val ? val : 1;
+		break;
+	    case 'n':
+		param.numInclude = val;
+		break;
+	    case 'm':
+		param.numMacro = val;
+		break;
+	    case 's':
+		param.seed = val;
+		break;
+	    default:
+		usage(argv[0]);
+	    }
+	} else if (argv[i][0] != '-' && dir.empty()) {
+	    dir = argv[i];
+	} else {
+	    usage(argv[0]);
+	}
+    }
+    if (dir.empty()) {
+	usage(argv[0]);
+    }
+    std::filesystem::create_directories(dir);
+
+    std::mt19937_64 rng{param.seed};
+
+    for (std::size_t k = 0; k < param.numInclude; ++k) {
+	auto path = dir / ("prog_inc" + std::to_string(k) + ".hdr");
+	std::ofstream out{path};
+	genHeader(out, k, param);
+    }
+
+    std::ofstream out{dir / "prog.abc"};
+    if (!out) {
+	std::cerr << "can not open " << (dir / "prog.abc") << std::endl;
+	std::exit(1);
+    }
+    genProgram(out, param, rng);
+}